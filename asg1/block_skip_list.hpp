@@ -0,0 +1,595 @@
+/**
+ * @file block_skip_list.hpp
+ * @brief Header-only implementation of an unrolled Skip List holding blocks of keys
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Unrolled variant of the Skip List, where each node holds a sorted block of up to B keys and
+ * their values, with the keys stored contiguously. The towers of forward pointers route on the
+ * first key of each block, so there is one tower per block rather than per key, and the position
+ * inside a block is found with the compare-and-count kernel of simd_search.hpp. Level 0 is thus
+ * scanned a few cache lines at a time rather than one node per key.
+ *
+ * A full block is split in two halves when a key is inserted into it. A block that drops below
+ * half full borrows keys from the block after it, or is merged with it if both fit in one block,
+ * so every block but the last is at least half full. Levels are managed as in Pugh's original
+ * algorithm: a new block gets a random level, and the list grows a level when a block is taller
+ * than every other block and shrinks when its top level becomes empty.
+ *
+ * Keys and values must be default constructible, as every block holds B of each.
+ *
+ * References:
+ * [1] William Pugh. Skip Lists: A Probabilistic Alternative to Balanced Trees.
+ *     Communications of the ACM, 33(6):668-676, 1990.
+ * [2] Zhihong Shao, John H. Reppy and Andrew W. Appel. Unrolling Lists. In Proceedings of the
+ *     1994 ACM Conference on LISP and Functional Programming, 185-195, 1994.
+ */
+#ifndef BLOCK_SKIP_LIST_HPP
+#define BLOCK_SKIP_LIST_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include "level_generator.hpp"
+#include "simd_search.hpp"
+#include "skip_list_node_pool.hpp"
+
+namespace DM803
+{
+template<class Key, class Value, std::size_t B>
+struct alignas(void *) BlockSkipListNode
+{
+	/**
+	 * @brief Creates a new empty Block Skip List Node object with a tower of exactly level
+	 *        forward pointers, laid out directly after the block
+	 *
+	 * @param pool Pool to take the memory for the node from
+	 * @param level Number of forward pointers
+	 * @return BlockSkipListNode* Pointer to the new node, to be released with destroy()
+	 */
+	template<class Pool>
+	static BlockSkipListNode *create(Pool &pool, const int level)
+	{
+		void *memory = pool.allocate(level);
+		try {
+			return new (memory) BlockSkipListNode(level);
+		} catch (...) {
+			pool.deallocate(memory, level);
+			throw;
+		}
+	}
+
+	/**
+	 * @brief Destroys a Block Skip List Node object created by create()
+	 *
+	 * @param pool Pool the node was created from
+	 * @param node Node to destroy
+	 */
+	template<class Pool>
+	static void destroy(Pool &pool, BlockSkipListNode *node)
+	{
+		int level{node->level};
+		node->~BlockSkipListNode();
+		pool.deallocate(node, level);
+	}
+
+	/**
+	 * @brief Returns the tower of forward pointers stored after the node
+	 *
+	 * @return BlockSkipListNode** Array of level forward pointers
+	 */
+	BlockSkipListNode **forward()
+	{
+		return reinterpret_cast<BlockSkipListNode **>(this + 1);
+	}
+
+	BlockSkipListNode *const *forward() const
+	{
+		return reinterpret_cast<BlockSkipListNode *const *>(this + 1);
+	}
+
+	// Number of forward pointers
+	int level{};
+
+	// Number of keys in use, which are the first count entries of keys and values
+	std::size_t count{0};
+
+	Key keys[B];
+	Value values[B];
+
+private:
+	explicit BlockSkipListNode(const int level)
+		: level(level)
+	{
+		std::uninitialized_fill_n(forward(), level, nullptr);
+	}
+};
+
+template<class Key, class Value, std::size_t B = (256 / sizeof(Key) < 4 ? 4 : 256 / sizeof(Key)),
+         class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
+class BlockSkipList
+{
+	static_assert(B >= 4, "blocks must hold at least 4 keys");
+
+	using Node = BlockSkipListNode<Key, Value, B>;
+	using NodePool = SkipListNodePool<Allocator>;
+
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using key_compare = Compare;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	// Maximum number of keys per block
+	static constexpr std::size_t BLOCK_SIZE{B};
+
+	// Default upper bound for the number of possible forward pointers
+	static constexpr int LEVEL_CAP{32};
+
+	// Largest accepted level cap, used to size the on-stack update arrays
+	static constexpr int MAX_LEVEL_CAP{64};
+
+	/**
+	 * @brief Constructs a new Block Skip List object
+	 *
+	 * @param p Constant between (0,1) defining number of blocks that are level i or greater
+	 * @param level_cap Upper bound for the number of possible forward pointers
+	 * @param comp Comparator defining the order of the keys
+	 * @param alloc Allocator to obtain node memory from
+	 */
+	explicit BlockSkipList(const double p=0.5, const int level_cap=LEVEL_CAP, const Compare &comp=Compare(),
+	                       const Allocator &alloc=Allocator())
+		: list_size(0),
+		  block_count(0),
+		  level_cap(std::max(1, std::min(level_cap, MAX_LEVEL_CAP))),
+		  max_level(1),
+		  p(p),
+		  comp(comp),
+		  node_pool(this->level_cap, sizeof(Node), sizeof(Node *), alignof(Node), alloc),
+		  sentinel(Node::create(node_pool, this->level_cap)),
+		  rng(std::random_device{}()),
+		  level_distribution(p, this->level_cap)
+	{
+		std::fill_n(sentinel->forward(), this->level_cap, sentinel);
+	}
+
+	BlockSkipList(const BlockSkipList &) = delete;
+	BlockSkipList &operator=(const BlockSkipList &) = delete;
+
+	/**
+	 * @brief Destroys the Block Skip List object
+	 *
+	 * Blocks of trivially destructible keys and values are not visited, but released in bulk
+	 * together with the slabs of the node pool.
+	 */
+	~BlockSkipList()
+	{
+		if constexpr (!std::is_trivially_destructible<Node>::value) {
+			Node *node = sentinel->forward()[0];
+			while (node != sentinel) {
+				Node *next = node->forward()[0];
+				node->~Node();
+				node = next;
+			}
+			sentinel->~Node();
+		}
+	}
+
+	/**
+	 * @brief Checks if the given key is in the Block Skip List
+	 *
+	 * @param search_key Key to find
+	 * @return bool True if key was found, false otherwise
+	 */
+	bool contains(const Key &search_key) const
+	{
+		return get(search_key) != nullptr;
+	}
+
+	/**
+	 * @brief Looks up the value stored for the given key
+	 *
+	 * @param search_key Key to find
+	 * @return Value* Pointer to the value, or null if the key is not present. The pointer is
+	 *                invalidated by the next insert or delete
+	 */
+	Value *get(const Key &search_key)
+	{
+		Node *node = find_block(search_key);
+		if (node == sentinel) {
+			return nullptr;
+		}
+		size_t position{position_in_block(node, search_key)};
+		return position < node->count && !comp(search_key, node->keys[position]) ? &node->values[position] : nullptr;
+	}
+
+	const Value *get(const Key &search_key) const
+	{
+		return const_cast<BlockSkipList *>(this)->get(search_key);
+	}
+
+	/**
+	 * @brief Visits the key-value pairs with keys in [lo, hi] in ascending key order
+	 *
+	 * @param lo Smallest key to visit
+	 * @param hi Largest key to visit
+	 * @param visit Callback invoked as visit(key, value)
+	 * @return size_t Number of pairs visited
+	 */
+	template<class Visitor>
+	size_t range_scan(const Key &lo, const Key &hi, Visitor visit) const
+	{
+		const Node *node = find_block(lo);
+		size_t position{0};
+		if (node == sentinel) {
+			node = sentinel->forward()[0];
+		} else {
+			position = position_in_block(node, lo);
+		}
+		size_t visited{0};
+		for (; node != sentinel; node = node->forward()[0], position = 0) {
+			for (; position < node->count; position++) {
+				if (comp(hi, node->keys[position])) {
+					return visited;
+				}
+				visit(node->keys[position], node->values[position]);
+				visited++;
+			}
+		}
+		return visited;
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Block Skip List, splitting the block it belongs in
+	 *        if that is full
+	 *
+	 * @param search_key Key to insert
+	 * @param new_value Value to insert
+	 * @return bool True if key and value was inserted, false if the key was already present
+	 */
+	template<class K, class V>
+	bool insert(K &&search_key, V &&new_value)
+	{
+		Node *update[MAX_LEVEL_CAP];
+		Node *node = traverse_list(search_key, update);
+		if (node == sentinel) {
+			// The key orders before every block, so it goes first in the first block
+			node = sentinel->forward()[0];
+			if (node == sentinel) {
+				node = add_block_after(sentinel, update);
+			}
+		}
+		size_t position{position_in_block(node, search_key)};
+		if (position < node->count && !comp(search_key, node->keys[position])) {
+			return false;
+		}
+		if (node->count == B) {
+			Node *right = split(node, update);
+			if (position > node->count) {
+				position -= node->count;
+				node = right;
+			}
+		}
+		std::move_backward(node->keys + position, node->keys + node->count, node->keys + node->count + 1);
+		std::move_backward(node->values + position, node->values + node->count, node->values + node->count + 1);
+		node->keys[position] = std::forward<K>(search_key);
+		node->values[position] = std::forward<V>(new_value);
+		node->count++;
+		list_size++;
+		return true;
+	}
+
+	/**
+	 * @brief Deletes the key, if present, from the Block Skip List, refilling its block from the
+	 *        next block if it drops below half full
+	 *
+	 * @param search_key Key to be deleted
+	 * @return bool True if key was found and deleted, false otherwise
+	 */
+	bool remove(const Key &search_key)
+	{
+		Node *update[MAX_LEVEL_CAP];
+		Node *node = traverse_list(search_key, update);
+		if (node == sentinel) {
+			return false;
+		}
+		size_t position{position_in_block(node, search_key)};
+		if (position == node->count || comp(search_key, node->keys[position])) {
+			return false;
+		}
+		std::move(node->keys + position + 1, node->keys + node->count, node->keys + position);
+		std::move(node->values + position + 1, node->values + node->count, node->values + position);
+		node->count--;
+		clear_slots(node, node->count, node->count + 1);
+		list_size--;
+		if (node->count == 0) {
+			// Only a block holding just the search key can become empty, and its first key was
+			// the search key, so the traversal stopped right before it on every level
+			remove_block(node, update);
+		} else if (node->count < B / 2) {
+			refill(node, update);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Returns the number of elements in the Block Skip List
+	 *
+	 * @return size_t
+	 */
+	size_t size() const
+	{
+		return list_size;
+	}
+
+	bool empty() const
+	{
+		return list_size == 0;
+	}
+
+	/**
+	 * @brief Returns the number of blocks in use
+	 *
+	 * @return size_t
+	 */
+	size_t blocks() const
+	{
+		return block_count;
+	}
+
+	key_compare key_comp() const
+	{
+		return comp;
+	}
+
+	allocator_type get_allocator() const
+	{
+		return node_pool.get_allocator();
+	}
+
+	/**
+	 * @brief Allows printing of the keys of the Block Skip List, block by block
+	 *
+	 * @param s Reference to output stream
+	 * @param l Block Skip List to print
+	 * @return std::ostream& Reference to output stream
+	 */
+	friend std::ostream &operator<<(std::ostream &s, const BlockSkipList &l)
+	{
+		for (const Node *node = l.sentinel->forward()[0]; node != l.sentinel; node = node->forward()[0]) {
+			if (node != l.sentinel->forward()[0]) {
+				s << "->";
+			}
+			s << "[";
+			for (size_t i = 0; i < node->count; i++) {
+				s << (i > 0 ? " " : "") << node->keys[i];
+			}
+			s << "]";
+		}
+		return s;
+	}
+
+private:
+	/**
+	 * @brief Finds the last block whose first key is <= search key
+	 *
+	 * @param search_key Key to search for
+	 * @return Node* The block, or the sentinel if the search key orders before every block
+	 */
+	Node *find_block(const Key &search_key) const
+	{
+		Node *node = sentinel;
+		for (size_t i = max_level; i > 0; i--) {
+			while (node->forward()[i-1] != sentinel && !comp(search_key, node->forward()[i-1]->keys[0])) {
+				node = node->forward()[i-1];
+			}
+		}
+		return node;
+	}
+
+	/**
+	 * @brief Traverses the Skip List, recording the last block at each level whose first key
+	 *        orders before the search key
+	 *
+	 * @param search_key Key to search for
+	 * @param update Local update array, with room for at least level cap entries
+	 * @return Node* The block the search key belongs in, or the sentinel if it orders before
+	 *               every block
+	 */
+	Node *traverse_list(const Key &search_key, Node **update) const
+	{
+		Node *node = sentinel;
+		for (size_t i = max_level; i > 0; i--) {
+			while (node->forward()[i-1] != sentinel && comp(node->forward()[i-1]->keys[0], search_key)) {
+				node = node->forward()[i-1];
+			}
+			update[i-1] = node;
+		}
+		Node *next = node->forward()[0];
+		if (next != sentinel && !comp(search_key, next->keys[0])) {
+			return next;
+		}
+		return node;
+	}
+
+	/**
+	 * @brief Finds the position of the first key >= search key in a block
+	 *
+	 * @param node Block to search
+	 * @param search_key Key to search for
+	 * @return size_t Position in [0,count]
+	 */
+	size_t position_in_block(const Node *node, const Key &search_key) const
+	{
+		return count_less(node->keys, node->count, search_key, comp);
+	}
+
+	/**
+	 * @brief Links a new empty block with a random level in after a block
+	 *
+	 * At levels the block does not reach, the new block is linked in after the update array,
+	 * which holds the last block at each level whose first key orders before the first key of
+	 * the block, or the sentinel.
+	 *
+	 * @param node Block, or sentinel, to link the new block in after
+	 * @param update Update array filled in by traverse_list
+	 * @return Node* The new block
+	 */
+	Node *add_block_after(Node *node, Node **update)
+	{
+		int level{random_level()};
+		for (int i = max_level; i < level; i++) {
+			update[i] = sentinel;
+		}
+		max_level = std::max(max_level, level);
+		Node *block = Node::create(node_pool, level);
+		for (size_t i = 0; i < static_cast<size_t>(level); i++) {
+			Node *previous = i < static_cast<size_t>(node->level) ? node : update[i];
+			block->forward()[i] = previous->forward()[i];
+			previous->forward()[i] = block;
+		}
+		block_count++;
+		return block;
+	}
+
+	/**
+	 * @brief Unlinks and destroys a block, given the last block before it on every level
+	 *
+	 * @param node Block to remove
+	 * @param previous Returns the block before it at a given level
+	 */
+	template<class Previous>
+	void unlink_block(Node *node, Previous previous)
+	{
+		for (size_t i = 0; i < static_cast<size_t>(node->level); i++) {
+			previous(i)->forward()[i] = node->forward()[i];
+		}
+		Node::destroy(node_pool, node);
+		block_count--;
+		while (max_level > 1 && sentinel->forward()[max_level-1] == sentinel) {
+			max_level--;
+		}
+	}
+
+	void remove_block(Node *node, Node **update)
+	{
+		unlink_block(node, [update](const size_t i) { return update[i]; });
+	}
+
+	/**
+	 * @brief Moves the upper half of a full block to a new block after it
+	 *
+	 * @param node Full block
+	 * @param update Update array filled in by traverse_list
+	 * @return Node* The new block
+	 */
+	Node *split(Node *node, Node **update)
+	{
+		Node *right = add_block_after(node, update);
+		std::move(node->keys + B / 2, node->keys + B, right->keys);
+		std::move(node->values + B / 2, node->values + B, right->values);
+		right->count = B - B / 2;
+		node->count = B / 2;
+		clear_slots(node, B / 2, B);
+		return right;
+	}
+
+	/**
+	 * @brief Refills a block that is less than half full from the block after it, by merging the
+	 *        two if they fit in one block, and by moving keys over so both are at least half full
+	 *        otherwise
+	 *
+	 * @param node Block to refill
+	 * @param update Update array filled in by traverse_list
+	 */
+	void refill(Node *node, Node **update)
+	{
+		Node *next = node->forward()[0];
+		if (next == sentinel) {
+			return;
+		}
+		size_t moved{node->count + next->count <= B ? next->count : (next->count - node->count) / 2};
+		std::move(next->keys, next->keys + moved, node->keys + node->count);
+		std::move(next->values, next->values + moved, node->values + node->count);
+		node->count += moved;
+		if (moved == next->count) {
+			// At the levels node reaches, node comes right before next, and at the levels above
+			// the update array does, as no block has a first key between theirs
+			unlink_block(next, [node, update](const size_t i) {
+				return i < static_cast<size_t>(node->level) ? node : update[i];
+			});
+		} else {
+			std::move(next->keys + moved, next->keys + next->count, next->keys);
+			std::move(next->values + moved, next->values + next->count, next->values);
+			next->count -= moved;
+			clear_slots(next, next->count, next->count + moved);
+		}
+	}
+
+	/**
+	 * @brief Resets unused slots of a block, so they do not keep moved-from keys and values alive
+	 *
+	 * @param node Block
+	 * @param first First slot to reset
+	 * @param last Slot after the last one to reset
+	 */
+	void clear_slots(Node *node, const size_t first, const size_t last)
+	{
+		if constexpr (!std::is_trivially_destructible<Key>::value || !std::is_trivially_destructible<Value>::value) {
+			std::fill(node->keys + first, node->keys + last, Key());
+			std::fill(node->values + first, node->values + last, Value());
+		}
+	}
+
+	/**
+	 * @brief Generates a random integer in the range [1,level cap] to use as the level for a
+	 *        new block
+	 *
+	 * @return int Positive integer in range [1,level cap]
+	 */
+	int random_level()
+	{
+		return level_distribution(rng);
+	}
+
+	size_t list_size{};
+
+	size_t block_count{};
+
+	// Upper bound for the number of possible forward pointers
+	const int level_cap{};
+
+	// Number of forward pointers currently in use
+	int max_level{};
+
+	// Constant between (0,1) defining number of blocks that are level i or greater
+	const double p{};
+
+	Compare comp;
+
+	// Owns the memory of all blocks of the list
+	NodePool node_pool;
+
+	// Head of every level, never holding keys
+	Node *sentinel;
+
+	// xoshiro256** engine seeded from std::random_device
+	Xoshiro256 rng;
+
+	// Turns one draw from the engine into a level
+	GeometricLevels level_distribution;
+};
+} // namespace DM803
+
+#endif // BLOCK_SKIP_LIST_HPP
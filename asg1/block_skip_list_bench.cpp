@@ -0,0 +1,329 @@
+/**
+ * @file block_skip_list_bench.cpp
+ * @brief Benchmark comparing the Skip List to the Block Skip List for a range of block sizes
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Inserts the same random keys into a Skip List and into Block Skip Lists with different block
+ * sizes, and reports the memory used per key and the time per insert, per point lookup and per
+ * range scan of 100 keys. Then reports the time per point lookup in the Skip List when the
+ * lookups are made in batches with search_batch(), for a range of group sizes, and finally the
+ * time per point lookup and per operation of a read-mostly workload with and without the
+ * express-lane index. Last, it reports the time per point lookup with the keys turned into
+ * strings, with and without the key prefixes stored in the nodes, against the integer keys.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "block_skip_list.hpp"
+#include "skip_list.hpp"
+
+// Bytes currently obtained through CountingAllocator
+static std::size_t allocated_bytes{0};
+
+/**
+ * Allocator forwarding to std::allocator while keeping track of the number of bytes in use
+ */
+template<class T>
+struct CountingAllocator
+{
+	using value_type = T;
+
+	CountingAllocator() = default;
+
+	template<class U>
+	CountingAllocator(const CountingAllocator<U> &)
+	{
+	}
+
+	T *allocate(const std::size_t n)
+	{
+		allocated_bytes += n * sizeof(T);
+		return std::allocator<T>().allocate(n);
+	}
+
+	void deallocate(T *memory, const std::size_t n)
+	{
+		allocated_bytes -= n * sizeof(T);
+		std::allocator<T>().deallocate(memory, n);
+	}
+
+	template<class U>
+	bool operator==(const CountingAllocator<U> &) const
+	{
+		return true;
+	}
+
+	template<class U>
+	bool operator!=(const CountingAllocator<U> &) const
+	{
+		return false;
+	}
+};
+
+using Allocator = CountingAllocator<std::pair<const int, int>>;
+
+/**
+ * @brief Prints a helper message to stdout for how to use this program
+ *
+ * @param program First argument from the command line, i.e. argv[0]
+ */
+static void show_usage(const std::string& program)
+{
+	std::cout << "Usage: " << program << " [<keys> [<lookups>]]\n"
+	          << "Arguments:\n"
+	          << "\tkeys\t\tOptional: Number of keys to insert. Default value is 1000000.\n"
+	          << "\tlookups\t\tOptional: Number of point lookups and of range scans. Default value\n"
+	          << "\t\t\tis 1000000.\n"
+	          << std::endl;
+}
+
+/**
+ * @brief Returns the time per operation since the given point in time
+ *
+ * @param begin Point in time the operations started
+ * @param operations Number of operations
+ * @return double Nanoseconds per operation
+ */
+static double nanoseconds_per_operation(const std::chrono::steady_clock::time_point begin, const std::size_t operations)
+{
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+	return elapsed.count() / operations;
+}
+
+/**
+ * @brief Runs the benchmark on one list type and prints a line of results
+ *
+ * @param name Name of the list type
+ * @param keys Keys to insert, in insertion order
+ * @param lookups Keys to look up and to start range scans from
+ */
+template<class List>
+static void run(const std::string &name, const std::vector<int> &keys, const std::vector<int> &lookups)
+{
+	List l(0.5);
+	std::size_t bytes_before{allocated_bytes};
+
+	auto begin = std::chrono::steady_clock::now();
+	for (int key : keys) {
+		l.insert(key, key);
+	}
+	double insert_time{nanoseconds_per_operation(begin, keys.size())};
+	double bytes_per_key{static_cast<double>(allocated_bytes - bytes_before) / keys.size()};
+
+	// The checksums keep the compiler from dropping the lookups
+	long found{0};
+	begin = std::chrono::steady_clock::now();
+	for (int key : lookups) {
+		found += l.get(key) != nullptr;
+	}
+	double lookup_time{nanoseconds_per_operation(begin, lookups.size())};
+
+	long scanned{0};
+	begin = std::chrono::steady_clock::now();
+	for (int key : lookups) {
+		l.range_scan(key, key + 199, [&scanned](const int &, const int &value) {
+			scanned += value;
+		});
+	}
+	double scan_time{nanoseconds_per_operation(begin, lookups.size())};
+
+	std::cout << name << "\t" << std::fixed << std::setprecision(1) << bytes_per_key << "\t\t"
+	          << insert_time << "\t\t" << lookup_time << "\t\t" << scan_time << "\t\t(" << found
+	          << " found, checksum " << scanned << ")" << std::endl;
+}
+
+/**
+ * Orders strings like std::less, but is a different type, so the Skip List stores no key prefixes
+ */
+template<class String>
+struct PlainLess
+{
+	bool operator()(const String &a, const String &b) const
+	{
+		return a < b;
+	}
+};
+
+/**
+ * @brief Turns an integer key into a string key of 24 letters, longer than the strings kept
+ *        inside std::string, so that different integers give different strings in random order
+ *
+ * @param key Integer key
+ * @return std::string String key
+ */
+static std::string string_key(const int key)
+{
+	std::string s(24, 'a');
+	std::uint64_t x{static_cast<std::uint64_t>(key) * 0x9e3779b97f4a7c15};
+	for (char &c : s) {
+		x ^= x >> 29;
+		x *= 0xbf58476d1ce4e5b9;
+		c = static_cast<char>('a' + (x >> 40) % 26);
+	}
+	return s;
+}
+
+/**
+ * @brief Times the lookups in a list of the given keys and prints a line of results
+ *
+ * @param name Name of the configuration
+ * @param keys Keys to insert, in insertion order
+ * @param lookups Keys to look up
+ */
+template<class List, class Key>
+static void run_keys(const std::string &name, const std::vector<Key> &keys, const std::vector<Key> &lookups)
+{
+	List l(0.5);
+	for (std::size_t i = 0; i < keys.size(); i++) {
+		l.insert(keys[i], static_cast<int>(i));
+	}
+	long found{0};
+	auto begin = std::chrono::steady_clock::now();
+	for (const Key &key : lookups) {
+		found += l.get(key) != nullptr;
+	}
+	double lookup_time{nanoseconds_per_operation(begin, lookups.size())};
+	std::cout << name << "\t" << std::fixed << std::setprecision(1) << lookup_time << "\t\t(" << found
+	          << " found)" << std::endl;
+}
+
+/**
+ * @brief Times the lookups made in batches through search_batch() with the given group size and
+ *        prints a line of results
+ *
+ * @param l Skip List to search
+ * @param lookups Keys to look up
+ */
+template<std::size_t G, class List>
+static void run_batched(const List &l, const std::vector<int> &lookups)
+{
+	std::vector<const int *> results(lookups.size());
+	auto begin = std::chrono::steady_clock::now();
+	l.template search_batch<G>(lookups.data(), lookups.size(), results.data());
+	double lookup_time{nanoseconds_per_operation(begin, lookups.size())};
+	long found{std::count_if(results.begin(), results.end(), [](const int *value) { return value != nullptr; })};
+	std::cout << "G=" << G << "\t\t" << std::fixed << std::setprecision(1) << lookup_time << "\t\t(" << found
+	          << " found)" << std::endl;
+}
+
+/**
+ * @brief Times point lookups alone and mixed with one insert or delete per 100 operations, and
+ *        prints a line of results
+ *
+ * @param name Name of the configuration
+ * @param l Skip List to search, holding the even keys
+ * @param lookups Keys to look up
+ */
+template<class List>
+static void run_indexed(const std::string &name, List &l, const std::vector<int> &lookups)
+{
+	long found{0};
+	auto begin = std::chrono::steady_clock::now();
+	for (int key : lookups) {
+		found += l.get(key) != nullptr;
+	}
+	double lookup_time{nanoseconds_per_operation(begin, lookups.size())};
+
+	// Every 100th operation inserts an odd key, or deletes the one inserted before, so the
+	// contents are the same afterwards
+	begin = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < lookups.size(); i++) {
+		if (i % 100 != 99) {
+			found += l.get(lookups[i]) != nullptr;
+		} else if (i % 200 == 99) {
+			l.insert(lookups[i] | 1, 0);
+		} else {
+			l.remove(lookups[i-100] | 1);
+		}
+	}
+	double mixed_time{nanoseconds_per_operation(begin, lookups.size())};
+	std::cout << name << "\t" << std::fixed << std::setprecision(1) << lookup_time << "\t\t" << mixed_time
+	          << "\t\t(" << found << " found)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	int key_count{1000000};
+	int lookup_count{1000000};
+	try {
+		if (argc > 1) {
+			key_count = std::stoi(argv[1]);
+		}
+		if (argc > 2) {
+			lookup_count = std::stoi(argv[2]);
+		}
+	} catch (std::exception &e) {
+		key_count = 0;
+	}
+	if (key_count < 1 || lookup_count < 1) {
+		show_usage(argv[0]);
+		return 1;
+	}
+
+	// Even keys are inserted, so half the lookups hit and a scan of 200 keys visits 100
+	std::mt19937 rng(42);
+	std::vector<int> keys(key_count);
+	for (int i = 0; i < key_count; i++) {
+		keys[i] = 2 * i;
+	}
+	std::shuffle(keys.begin(), keys.end(), rng);
+	std::vector<int> lookups(lookup_count);
+	std::uniform_int_distribution<> key_distribution(0, 2 * key_count - 1);
+	for (int &key : lookups) {
+		key = key_distribution(rng);
+	}
+
+	std::cout << "keys = " << key_count << ", lookups = " << lookup_count << std::endl;
+	std::cout << "list\t\tbytes/key\tinsert ns\tlookup ns\tscan ns (100 keys)" << std::endl;
+	run<DM803::SkipList<int, int, std::less<int>, Allocator>>("skip list", keys, lookups);
+	run<DM803::BlockSkipList<int, int, 8, std::less<int>, Allocator>>("block B=8", keys, lookups);
+	run<DM803::BlockSkipList<int, int, 16, std::less<int>, Allocator>>("block B=16", keys, lookups);
+	run<DM803::BlockSkipList<int, int, 32, std::less<int>, Allocator>>("block B=32", keys, lookups);
+	run<DM803::BlockSkipList<int, int, 64, std::less<int>, Allocator>>("block B=64", keys, lookups);
+	run<DM803::BlockSkipList<int, int, 128, std::less<int>, Allocator>>("block B=128", keys, lookups);
+
+	std::cout << "\nskip list search_batch()\ngroup\t\tlookup ns" << std::endl;
+	DM803::SkipList<int, int> l(0.5);
+	for (int key : keys) {
+		l.insert(key, key);
+	}
+	run_batched<1>(l, lookups);
+	run_batched<4>(l, lookups);
+	run_batched<8>(l, lookups);
+	run_batched<16>(l, lookups);
+	run_batched<32>(l, lookups);
+
+	std::cout << "\nskip list express-lane index\nindex\t\tlookup ns\t100:1 mixed ns" << std::endl;
+	run_indexed("off", l, lookups);
+	l.use_index(true);
+	run_indexed("on", l, lookups);
+
+	std::vector<std::string> string_keys;
+	std::vector<std::string> string_lookups;
+	std::transform(keys.begin(), keys.end(), std::back_inserter(string_keys), string_key);
+	std::transform(lookups.begin(), lookups.end(), std::back_inserter(string_lookups), string_key);
+	std::vector<std::string_view> view_keys(string_keys.begin(), string_keys.end());
+	std::vector<std::string_view> view_lookups(string_lookups.begin(), string_lookups.end());
+	std::cout << "\nskip list key types\nkeys\t\tlookup ns" << std::endl;
+	run_keys<DM803::SkipList<int, int>>("int", keys, lookups);
+	run_keys<DM803::SkipList<std::string, int, PlainLess<std::string>>>("string", string_keys, string_lookups);
+	run_keys<DM803::SkipList<std::string, int>>("string prefix", string_keys, string_lookups);
+	run_keys<DM803::SkipList<std::string_view, int, PlainLess<std::string_view>>>("view", view_keys, view_lookups);
+	run_keys<DM803::SkipList<std::string_view, int>>("view prefix", view_keys, view_lookups);
+	return 0;
+}
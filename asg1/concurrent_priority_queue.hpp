@@ -0,0 +1,158 @@
+/**
+ * @file concurrent_priority_queue.hpp
+ * @brief Lock-free concurrent priority queue on top of the Concurrent Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Priority queue for many threads at once, keeping its elements in a Concurrent Skip List keyed
+ * by priority and a sequence number. The sequence number lets several elements have the same
+ * priority and makes elements of equal priority come out in the order they were pushed. Taking
+ * the smallest element claims the first node of the list, without a search.
+ */
+#ifndef CONCURRENT_PRIORITY_QUEUE_HPP
+#define CONCURRENT_PRIORITY_QUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "concurrent_skip_list.hpp"
+
+namespace DM803
+{
+template<class Priority, class Value, class Compare = std::less<Priority>>
+class ConcurrentPriorityQueue
+{
+	using Key = std::pair<Priority, std::uint64_t>;
+
+	/**
+	 * Orders keys by priority, and keys of equal priority by sequence number
+	 */
+	struct KeyCompare
+	{
+		bool operator()(const Key &a, const Key &b) const
+		{
+			if (comp(a.first, b.first)) {
+				return true;
+			}
+			if (comp(b.first, a.first)) {
+				return false;
+			}
+			return a.second < b.second;
+		}
+
+		Compare comp;
+	};
+
+public:
+	/**
+	 * @brief Constructs a new Concurrent Priority Queue object
+	 *
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater
+	 * @param level_cap Upper bound for the number of possible forward pointers
+	 * @param comp Comparator defining the order of the priorities, smallest first
+	 */
+	explicit ConcurrentPriorityQueue(const double p=0.5, const int level_cap=32, const Compare &comp=Compare())
+		: list(p, level_cap, KeyCompare{comp})
+	{
+	}
+
+	/**
+	 * @brief Adds an element to the Concurrent Priority Queue
+	 *
+	 * @param priority Priority of the element
+	 * @param value Value of the element
+	 */
+	void push(const Priority &priority, const Value &value)
+	{
+		list.insert(Key(priority, sequence.fetch_add(1, std::memory_order_relaxed)), value);
+	}
+
+	/**
+	 * @brief Copies the element with the smallest priority without taking it out
+	 *
+	 * @param priority If not null and the queue is not empty, receives its priority
+	 * @param value If not null and the queue is not empty, receives its value
+	 * @return bool True if the queue was not empty
+	 */
+	bool peek_min(Priority *priority=nullptr, Value *value=nullptr)
+	{
+		Key key;
+		if (!list.peek_min(&key, value)) {
+			return false;
+		}
+		if (priority != nullptr) {
+			*priority = key.first;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Takes out the element with the smallest priority, the earliest pushed among equals
+	 *
+	 * @param priority If not null and an element was taken out, receives its priority
+	 * @param value If not null and an element was taken out, receives its value
+	 * @return bool True if an element was taken out, false if the queue was empty
+	 */
+	bool pop_min(Priority *priority=nullptr, Value *value=nullptr)
+	{
+		Key key;
+		if (!list.pop_min(&key, value)) {
+			return false;
+		}
+		if (priority != nullptr) {
+			*priority = key.first;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Takes out one of the spread elements with the smallest priorities, chosen at random.
+	 *        With a spread of about the number of threads popping, they seldom contend
+	 *
+	 * @param spread Number of elements to choose among, where 1 is the same as pop_min()
+	 * @param priority If not null and an element was taken out, receives its priority
+	 * @param value If not null and an element was taken out, receives its value
+	 * @return bool True if an element was taken out, false if the queue was empty
+	 */
+	bool pop_min_relaxed(const size_t spread, Priority *priority=nullptr, Value *value=nullptr)
+	{
+		Key key;
+		if (!list.pop_min_relaxed(spread, &key, value)) {
+			return false;
+		}
+		if (priority != nullptr) {
+			*priority = key.first;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Returns the number of elements in the Concurrent Priority Queue, which is exact
+	 *        when no operation is in progress and approximate otherwise
+	 *
+	 * @return size_t
+	 */
+	size_t size() const
+	{
+		return list.size();
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+private:
+	ConcurrentSkipList<Key, Value, KeyCompare> list;
+
+	// Sequence number of the next element pushed
+	std::atomic<std::uint64_t> sequence{0};
+};
+} // namespace DM803
+
+#endif // CONCURRENT_PRIORITY_QUEUE_HPP
@@ -0,0 +1,671 @@
+/**
+ * @file concurrent_skip_list.hpp
+ * @brief Lock-free concurrent Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Lock-free Skip List in the style of Fraser and Herlihy-Shavit. Forward pointers are updated with
+ * CAS, and a node is deleted logically by setting the low bit (the mark) of each of its forward
+ * pointers, top level first and level 0 last, the thread marking level 0 being the one that
+ * deleted the key. Marked nodes are unlinked physically by any traversal that runs into them.
+ *
+ * Unlinked nodes are handed to an epoch manager, so a node is only freed once no thread can still
+ * be reading it. A node is retired once both its inserter has finished linking its tower and its
+ * remover has unlinked it, since an inserter racing with the remover may otherwise link an upper
+ * level of the node after the remover has unlinked it.
+ *
+ * The smallest key can be deleted without a search by claiming the first node at level 0, which
+ * makes the list a concurrent priority queue [3], optionally relaxed to spread the threads over
+ * the first few nodes [4]. concurrent_priority_queue.hpp wraps this up with duplicate priorities.
+ *
+ * References:
+ * [1] Keir Fraser. Practical lock-freedom. PhD thesis, University of Cambridge, 2004.
+ * [2] Maurice Herlihy and Nir Shavit. The Art of Multiprocessor Programming, chapter 14.
+ *     Morgan Kaufmann, 2008.
+ * [3] Itay Lotan and Nir Shavit. Skiplist-based concurrent priority queues. IPDPS 2000.
+ * [4] Dan Alistarh, Justin Kopinsky, Jerry Li and Nir Shavit. The SprayList: a scalable relaxed
+ *     priority queue. PPoPP 2015.
+ */
+#ifndef CONCURRENT_SKIP_LIST_HPP
+#define CONCURRENT_SKIP_LIST_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <random>
+#include <utility>
+
+#include "epoch_reclamation.hpp"
+#include "level_generator.hpp"
+
+namespace DM803
+{
+template<class Key, class Value, class Compare = std::less<Key>>
+class ConcurrentSkipList
+{
+public:
+	// Largest number of levels a node can have
+	static constexpr int MAX_LEVEL_CAP{64};
+
+	/**
+	 * @brief Constructs a new Concurrent Skip List object
+	 *
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater
+	 * @param level_cap Upper bound for the number of possible forward pointers
+	 * @param comp Comparator defining the order of the keys
+	 */
+	explicit ConcurrentSkipList(const double p=0.5, const int level_cap=32, const Compare &comp=Compare())
+		: p(p),
+		  level_cap(std::max(1, std::min(level_cap, MAX_LEVEL_CAP))),
+		  comp(comp),
+		  level_distribution(p, this->level_cap),
+		  head(Node::create_head(this->level_cap))
+	{
+	}
+
+	ConcurrentSkipList(const ConcurrentSkipList &) = delete;
+	ConcurrentSkipList &operator=(const ConcurrentSkipList &) = delete;
+
+	/**
+	 * @brief Destroys the Concurrent Skip List object
+	 *
+	 * No other thread may access the list while it is destroyed. Nodes still linked at level 0
+	 * are freed here, while nodes already retired are freed by the epoch manager.
+	 */
+	~ConcurrentSkipList()
+	{
+		Node *node = Node::pointer(head->next()[0].load());
+		while (node != nullptr) {
+			Node *next = Node::pointer(node->next()[0].load());
+			Node::destroy(node);
+			node = next;
+		}
+		Node::destroy_head(head);
+	}
+
+	/**
+	 * @brief Searches the Concurrent Skip List for the given key without modifying it
+	 *
+	 * @param search_key Key to find
+	 * @param value If not null and the key is found, receives a copy of the value
+	 * @return bool True if the key was found, false otherwise
+	 */
+	bool search(const Key &search_key, Value *value=nullptr)
+	{
+		EpochManager::Guard guard(epochs);
+
+		Node *pred = head;
+		Node *curr = nullptr;
+		for (int i = max_level.load(std::memory_order_relaxed); i > 0; i--) {
+			curr = Node::pointer(pred->next()[i-1].load(std::memory_order_acquire));
+			while (curr != nullptr) {
+				std::uintptr_t succ{curr->next()[i-1].load(std::memory_order_acquire)};
+				if (Node::is_marked(succ)) {
+					curr = Node::pointer(succ);
+				} else if (comp(curr->key(), search_key)) {
+					pred = curr;
+					curr = Node::pointer(succ);
+				} else {
+					break;
+				}
+			}
+		}
+		if (curr != nullptr && !comp(search_key, curr->key())) {
+			if (value != nullptr) {
+				*value = curr->value();
+			}
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Concurrent Skip List
+	 *
+	 * @param search_key Key to insert
+	 * @param new_value Value to insert
+	 * @return bool True if key and value was inserted, false otherwise (e.g. key already present)
+	 */
+	bool insert(const Key &search_key, const Value &new_value)
+	{
+		EpochManager::Guard guard(epochs);
+
+		Node *preds[MAX_LEVEL_CAP];
+		Node *succs[MAX_LEVEL_CAP];
+
+		const int level{random_level()};
+		Node *node = nullptr;
+		while (true) {
+			if (find(search_key, preds, succs, level)) {
+				if (node != nullptr) {
+					Node::destroy(node); // Never published, so no other thread can have seen it
+				}
+				return false;
+			}
+			if (node == nullptr) {
+				node = Node::create(level, search_key, new_value);
+			}
+			for (int i = 0; i < level; i++) {
+				node->next()[i].store(Node::raw(succs[i]), std::memory_order_relaxed);
+			}
+			std::uintptr_t expected{Node::raw(succs[0])};
+			if (preds[0]->next()[0].compare_exchange_strong(expected, Node::raw(node))) {
+				break;
+			}
+		}
+		list_size.fetch_add(1, std::memory_order_relaxed);
+		link_upper_levels(node, search_key, preds, succs);
+		raise_max_level(level);
+
+		// A concurrent remove may have marked the node while the tower was being linked, possibly
+		// after its own unlinking pass, so make sure no level still points to it
+		if (Node::is_marked(node->next()[0].load())) {
+			find(search_key, preds, succs, level);
+		}
+		release(node);
+		return true;
+	}
+
+	/**
+	 * @brief Deletes the key, if present, from the Concurrent Skip List
+	 *
+	 * @param search_key Key to be deleted
+	 * @return bool True if key was found and deleted, false otherwise
+	 */
+	bool remove(const Key &search_key)
+	{
+		EpochManager::Guard guard(epochs);
+
+		Node *preds[MAX_LEVEL_CAP];
+		Node *succs[MAX_LEVEL_CAP];
+
+		if (!find(search_key, preds, succs, 1)) {
+			return false;
+		}
+		return remove_node(succs[0], search_key, preds, succs);
+	}
+
+	/**
+	 * @brief Copies the smallest key and its value without deleting them
+	 *
+	 * @param key If not null and the list is not empty, receives a copy of the smallest key
+	 * @param value If not null and the list is not empty, receives a copy of its value
+	 * @return bool True if a key was found, false if the list was empty
+	 */
+	bool peek_min(Key *key=nullptr, Value *value=nullptr)
+	{
+		EpochManager::Guard guard(epochs);
+
+		Node *node = Node::pointer(head->next()[0].load(std::memory_order_acquire));
+		while (node != nullptr) {
+			std::uintptr_t next{node->next()[0].load(std::memory_order_acquire)};
+			if (!Node::is_marked(next)) {
+				copy_out(node, key, value);
+				return true;
+			}
+			node = Node::pointer(next);
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Deletes the smallest key, as in the priority queue of Lotan and Shavit
+	 *
+	 * The first node at level 0 that is not yet deleted is claimed by marking it, and a thread
+	 * that loses the race for it moves on to the next one, so no descent is needed and the
+	 * expected time is O(1) besides unlinking the node. A key inserted concurrently may be smaller
+	 * than the one deleted.
+	 *
+	 * @param key If not null and a key was deleted, receives a copy of it
+	 * @param value If not null and a key was deleted, receives a copy of its value
+	 * @return bool True if a key was deleted, false if the list was empty
+	 */
+	bool pop_min(Key *key=nullptr, Value *value=nullptr)
+	{
+		EpochManager::Guard guard(epochs);
+
+		return claim_from(Node::pointer(head->next()[0].load(std::memory_order_acquire)), 0, key, value);
+	}
+
+	/**
+	 * @brief Deletes one of the smallest keys, chosen at random among the first spread keys in
+	 *        the manner of the SprayList, so that threads popping at the same time mostly claim
+	 *        different nodes instead of all contending for the first one
+	 *
+	 * Falls back to deleting the smallest key if fewer than spread keys remain after the one
+	 * chosen.
+	 *
+	 * @param spread Number of smallest keys to choose among, where 1 is the same as pop_min()
+	 * @param key If not null and a key was deleted, receives a copy of it
+	 * @param value If not null and a key was deleted, receives a copy of its value
+	 * @return bool True if a key was deleted, false if the list was empty
+	 */
+	bool pop_min_relaxed(const size_t spread, Key *key=nullptr, Value *value=nullptr)
+	{
+		thread_local Xoshiro256 rng{std::random_device{}()};
+		size_t skip{spread > 1 ? std::uniform_int_distribution<size_t>(0, spread - 1)(rng) : 0};
+
+		EpochManager::Guard guard(epochs);
+
+		Node *first = Node::pointer(head->next()[0].load(std::memory_order_acquire));
+		return claim_from(first, skip, key, value) || claim_from(first, 0, key, value);
+	}
+
+	/**
+	 * @brief Visits every key-value pair in ascending key order
+	 *
+	 * Keys inserted or deleted concurrently with the traversal may or may not be visited.
+	 *
+	 * @param visit Callback invoked as visit(key, value)
+	 */
+	template<class Visitor>
+	void for_each(Visitor visit)
+	{
+		EpochManager::Guard guard(epochs);
+
+		Node *node = Node::pointer(head->next()[0].load(std::memory_order_acquire));
+		while (node != nullptr) {
+			std::uintptr_t next{node->next()[0].load(std::memory_order_acquire)};
+			if (!Node::is_marked(next)) {
+				visit(node->key(), node->value());
+			}
+			node = Node::pointer(next);
+		}
+	}
+
+	/**
+	 * @brief Visits the key-value pairs with keys in [lo, hi] in ascending key order, after one
+	 *        descent to lo
+	 *
+	 * Keys inserted or deleted concurrently with the traversal may or may not be visited.
+	 *
+	 * @param lo Smallest key to visit
+	 * @param hi Largest key to visit
+	 * @param visit Callback invoked as visit(key, value)
+	 * @return size_t Number of pairs visited
+	 */
+	template<class Visitor>
+	size_t range_scan(const Key &lo, const Key &hi, Visitor visit)
+	{
+		EpochManager::Guard guard(epochs);
+
+		Node *pred = head;
+		for (int i = max_level.load(std::memory_order_relaxed); i > 0; i--) {
+			Node *curr = Node::pointer(pred->next()[i-1].load(std::memory_order_acquire));
+			while (curr != nullptr) {
+				std::uintptr_t succ{curr->next()[i-1].load(std::memory_order_acquire)};
+				if (Node::is_marked(succ)) {
+					curr = Node::pointer(succ);
+				} else if (comp(curr->key(), lo)) {
+					pred = curr;
+					curr = Node::pointer(succ);
+				} else {
+					break;
+				}
+			}
+		}
+		size_t visited{0};
+		Node *node = Node::pointer(pred->next()[0].load(std::memory_order_acquire));
+		while (node != nullptr && !comp(hi, node->key())) {
+			std::uintptr_t next{node->next()[0].load(std::memory_order_acquire)};
+			if (!Node::is_marked(next) && !comp(node->key(), lo)) {
+				visit(node->key(), node->value());
+				visited++;
+			}
+			node = Node::pointer(next);
+		}
+		return visited;
+	}
+
+	/**
+	 * @brief Returns the number of elements in the Concurrent Skip List
+	 *
+	 * The count is exact when no operation is in progress and approximate otherwise.
+	 *
+	 * @return size_t
+	 */
+	size_t size() const
+	{
+		return list_size.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct alignas(void *) Node
+	{
+		/**
+		 * @brief Creates a new node with a tower of level forward pointers in one allocation
+		 *
+		 * @param level Number of forward pointers
+		 * @param key Key
+		 * @param value Value
+		 * @return Node* Pointer to the new node, to be released with destroy()
+		 */
+		static Node *create(const int level, const Key &key, const Value &value)
+		{
+			Node *node = new (::operator new(bytes(level))) Node(level);
+			new (node->key_storage) Key(key);
+			new (node->value_storage) Value(value);
+			return node;
+		}
+
+		/**
+		 * @brief Creates the head of the list, which has a tower but never holds a key or value
+		 *
+		 * @param level Number of forward pointers
+		 * @return Node* Pointer to the head, to be released with destroy_head()
+		 */
+		static Node *create_head(const int level)
+		{
+			return new (::operator new(bytes(level))) Node(level);
+		}
+
+		static void destroy(Node *node)
+		{
+			node->key().~Key();
+			node->value().~Value();
+			destroy_head(node);
+		}
+
+		static void destroy_head(Node *node)
+		{
+			node->~Node();
+			::operator delete(node);
+		}
+
+		/**
+		 * @brief Reclaims a retired node, used as callback for the epoch manager
+		 *
+		 * @param node Node to reclaim
+		 */
+		static void reclaim(void *node)
+		{
+			destroy(static_cast<Node *>(node));
+		}
+
+		static std::size_t bytes(const int level)
+		{
+			return sizeof(Node) + level * sizeof(std::atomic<std::uintptr_t>);
+		}
+
+		static Node *pointer(const std::uintptr_t raw)
+		{
+			return reinterpret_cast<Node *>(raw & ~MARK);
+		}
+
+		static std::uintptr_t raw(const Node *node)
+		{
+			return reinterpret_cast<std::uintptr_t>(node);
+		}
+
+		static bool is_marked(const std::uintptr_t raw)
+		{
+			return (raw & MARK) != 0;
+		}
+
+		/**
+		 * @brief Returns the tower of forward pointers stored after the node. The low bit of a
+		 *        forward pointer is set when the node has been deleted at that level
+		 *
+		 * @return std::atomic<std::uintptr_t>* Array of level forward pointers
+		 */
+		std::atomic<std::uintptr_t> *next()
+		{
+			return reinterpret_cast<std::atomic<std::uintptr_t> *>(this + 1);
+		}
+
+		const Key &key() const
+		{
+			return *std::launder(reinterpret_cast<const Key *>(key_storage));
+		}
+
+		Key &key()
+		{
+			return *std::launder(reinterpret_cast<Key *>(key_storage));
+		}
+
+		Value &value()
+		{
+			return *std::launder(reinterpret_cast<Value *>(value_storage));
+		}
+
+		static constexpr std::uintptr_t MARK{1};
+
+		// Number of forward pointers
+		const int level;
+
+		// Number of parties (inserter and remover) still to finish with the node before it can be
+		// retired
+		std::atomic<int> pending{2};
+
+		alignas(Key) unsigned char key_storage[sizeof(Key)];
+		alignas(Value) unsigned char value_storage[sizeof(Value)];
+
+	private:
+		explicit Node(const int level)
+			: level(level)
+		{
+			for (int i = 0; i < level; i++) {
+				new (&next()[i]) std::atomic<std::uintptr_t>(0);
+			}
+		}
+	};
+
+	/**
+	 * @brief Finds the predecessors and successors of the search key at every level, unlinking
+	 *        marked nodes along the way
+	 *
+	 * @param search_key Key to search for
+	 * @param preds Receives the last node with key < search key at each level
+	 * @param succs Receives the first node with key >= search key at each level, or null
+	 * @param min_level Fill in preds and succs for at least this many levels
+	 * @return bool True if an unmarked node with the search key was found at level 0
+	 */
+	bool find(const Key &search_key, Node **preds, Node **succs, const int min_level)
+	{
+		const int top{std::max(max_level.load(std::memory_order_relaxed), min_level)};
+	retry:
+		Node *pred = head;
+		for (int i = top; i > 0; i--) {
+			Node *curr = Node::pointer(pred->next()[i-1].load(std::memory_order_acquire));
+			while (curr != nullptr) {
+				std::uintptr_t succ{curr->next()[i-1].load(std::memory_order_acquire)};
+				if (Node::is_marked(succ)) {
+					std::uintptr_t expected{Node::raw(curr)};
+					if (!pred->next()[i-1].compare_exchange_strong(expected, succ & ~Node::MARK)) {
+						goto retry;
+					}
+					curr = Node::pointer(succ);
+				} else if (comp(curr->key(), search_key)) {
+					pred = curr;
+					curr = Node::pointer(succ);
+				} else {
+					break;
+				}
+			}
+			preds[i-1] = pred;
+			succs[i-1] = curr;
+		}
+		return succs[0] != nullptr && !comp(search_key, succs[0]->key());
+	}
+
+	/**
+	 * @brief Links the levels above 0 of a node that has just been linked at level 0
+	 *
+	 * Linking stops early if the node is deleted in the meantime.
+	 *
+	 * @param node Node to link
+	 * @param search_key Key of the node
+	 * @param preds Predecessors of the node at each level
+	 * @param succs Successors of the node at each level
+	 */
+	void link_upper_levels(Node *node, const Key &search_key, Node **preds, Node **succs)
+	{
+		for (int i = 1; i < node->level; i++) {
+			while (true) {
+				std::uintptr_t next{node->next()[i].load()};
+				if (Node::is_marked(next)) {
+					return;
+				}
+				if (Node::pointer(next) != succs[i]
+				    && !node->next()[i].compare_exchange_strong(next, Node::raw(succs[i]))) {
+					return; // Only fails if the node was marked at this level
+				}
+				std::uintptr_t expected{Node::raw(succs[i])};
+				if (preds[i]->next()[i].compare_exchange_strong(expected, Node::raw(node))) {
+					break;
+				}
+				find(search_key, preds, succs, node->level);
+				if (succs[0] != node) {
+					return; // The node has been deleted and unlinked at level 0
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Deletes a node by marking its tower, then unlinks it
+	 *
+	 * @param node Node to delete
+	 * @param search_key Key of the node
+	 * @param preds Scratch array for predecessors
+	 * @param succs Scratch array for successors
+	 * @return bool True if this thread deleted the node, false if another thread got there first
+	 */
+	bool remove_node(Node *node, const Key &search_key, Node **preds, Node **succs)
+	{
+		for (int i = node->level - 1; i > 0; i--) {
+			std::uintptr_t next{node->next()[i].load()};
+			while (!Node::is_marked(next)
+			       && !node->next()[i].compare_exchange_weak(next, next | Node::MARK)) {
+			}
+		}
+		std::uintptr_t next{node->next()[0].load()};
+		while (true) {
+			if (Node::is_marked(next)) {
+				return false;
+			}
+			if (node->next()[0].compare_exchange_weak(next, next | Node::MARK)) {
+				break;
+			}
+		}
+		list_size.fetch_sub(1, std::memory_order_relaxed);
+		find(search_key, preds, succs, node->level);
+		release(node);
+		return true;
+	}
+
+	/**
+	 * @brief Deletes the first node not yet deleted at level 0, starting from the given node and
+	 *        passing over the given number of such nodes first. Must be called under a guard
+	 *
+	 * @param node Node to start from, or null
+	 * @param skip Number of nodes not yet deleted to pass over before trying to delete one
+	 * @param key If not null and a node was deleted, receives a copy of its key
+	 * @param value If not null and a node was deleted, receives a copy of its value
+	 * @return bool True if this thread deleted a node, false if it reached the end of the list
+	 */
+	bool claim_from(Node *node, size_t skip, Key *key, Value *value)
+	{
+		Node *preds[MAX_LEVEL_CAP];
+		Node *succs[MAX_LEVEL_CAP];
+
+		while (node != nullptr) {
+			std::uintptr_t next{node->next()[0].load(std::memory_order_acquire)};
+			if (!Node::is_marked(next)) {
+				if (skip > 0) {
+					skip--;
+				} else if (remove_node(node, node->key(), preds, succs)) {
+					// The guard keeps the node from being freed until the copies are made
+					copy_out(node, key, value);
+					return true;
+				}
+			}
+			node = Node::pointer(next);
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Copies the key and value of a node to where the caller asked for them
+	 *
+	 * @param node Node to copy from
+	 * @param key If not null, receives a copy of the key
+	 * @param value If not null, receives a copy of the value
+	 */
+	static void copy_out(Node *node, Key *key, Value *value)
+	{
+		if (key != nullptr) {
+			*key = node->key();
+		}
+		if (value != nullptr) {
+			*value = node->value();
+		}
+	}
+
+	/**
+	 * @brief Drops one of the two references held by the inserter and the remover of a node,
+	 *        retiring the node when both are done with it
+	 *
+	 * @param node Node to release
+	 */
+	void release(Node *node)
+	{
+		if (node->pending.fetch_sub(1) == 1) {
+			epochs.retire(node, &Node::reclaim);
+		}
+	}
+
+	/**
+	 * @brief Raises the level searches start from, the concurrent counterpart of
+	 *        increase_max_level_of_list in SkipList
+	 *
+	 * @param level Level of a newly linked node
+	 */
+	void raise_max_level(const int level)
+	{
+		int current{max_level.load(std::memory_order_relaxed)};
+		while (current < level && !max_level.compare_exchange_weak(current, level)) {
+		}
+	}
+
+	/**
+	 * @brief Generates a random integer in the range [1,level cap] to use as the level for a
+	 *        new node, using a random number engine private to the calling thread
+	 *
+	 * @return int Positive integer in range [1,level cap]
+	 */
+	int random_level()
+	{
+		thread_local Xoshiro256 rng{std::random_device{}()};
+		return level_distribution(rng);
+	}
+
+	// Constant between (0,1) defining number of elements that are level i or greater
+	const double p{};
+
+	// Upper bound for the number of possible forward pointers
+	const int level_cap{};
+
+	Compare comp;
+
+	// Turns one draw from the engine of the calling thread into a level
+	const GeometricLevels level_distribution;
+
+	Node *head;
+
+	// Highest level of any node linked so far, only ever increases
+	std::atomic<int> max_level{1};
+
+	std::atomic<size_t> list_size{0};
+
+	EpochManager epochs;
+};
+} // namespace DM803
+
+#endif // CONCURRENT_SKIP_LIST_HPP
@@ -0,0 +1,266 @@
+/**
+ * @file concurrent_skip_list_bench.cpp
+ * @brief Throughput benchmark for the lock-free Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Measures the throughput of a mixed search/insert/delete workload on one shared Concurrent Skip
+ * List for 1, 2, 4, ... up to the given number of threads, and on one Sharded Skip List, which
+ * locks a shard for every operation instead. Then does the same for a workload of
+ * pushes each followed by a pop of the smallest element, comparing the Concurrent Priority Queue,
+ * with exact and relaxed pops, to a binary heap behind a mutex.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_priority_queue.hpp"
+#include "concurrent_skip_list.hpp"
+#include "sharded_skip_list.hpp"
+
+/**
+ * Enum to choose the priority queue to run, where
+ *   - exact pops the smallest element of the Concurrent Priority Queue,
+ *   - relaxed pops one of the smallest elements of the Concurrent Priority Queue, chosen among as
+ *     many as there are threads, and
+ *   - heap is a std::priority_queue behind a mutex
+ */
+enum class Queue {exact, relaxed, heap};
+
+/**
+ * @brief Prints a helper message to stdout for how to use this program
+ *
+ * @param program First argument from the command line, i.e. argv[0]
+ */
+static void show_usage(const std::string& program)
+{
+	std::cout << "Usage: " << program << " [<threads> [<keys> [<search percentage> [<p>]]]]\n"
+	          << "Arguments:\n"
+	          << "\tthreads\t\tOptional: Largest number of threads. Default value is the number of cores.\n"
+	          << "\tkeys\t\tOptional: Size of the key range. Default value is 1000000.\n"
+	          << "\tsearch\t\tOptional: Percentage of searches, the rest are split evenly between\n"
+	          << "\t\t\tinserts and deletes. Default value is 90.\n"
+	          << "\tp\t\tOptional: Value of p. Default value is 1/e = 0.36788.\n"
+	          << std::endl;
+}
+
+/**
+ * @brief Runs the workload with the given number of threads for a fixed amount of time
+ *
+ * @param l Empty list to run the workload on
+ * @param threads Number of threads
+ * @param keys Size of the key range
+ * @param search_percentage Percentage of operations that are searches
+ * @return double Operations per second
+ */
+template<class List>
+static double run(List &l, const int threads, const int keys, const int search_percentage)
+{
+	// Prefill to half the key range, so inserts and deletes succeed about equally often
+	std::vector<int> prefill(keys);
+	for (int key = 0; key < keys; key++) {
+		prefill[key] = key;
+	}
+	std::shuffle(prefill.begin(), prefill.end(), std::mt19937(42));
+	for (int i = 0; i < keys / 2; i++) {
+		l.insert(prefill[i], prefill[i]);
+	}
+
+	std::atomic<bool> start{false};
+	std::atomic<bool> stop{false};
+	std::vector<long> operations(threads);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t]() {
+			std::mt19937 rng(t + 1);
+			std::uniform_int_distribution<> key_distribution(0, keys - 1);
+			std::uniform_int_distribution<> operation_distribution(0, 99);
+			while (!start.load()) {
+			}
+			long done{0};
+			while (!stop.load(std::memory_order_relaxed)) {
+				for (int i = 0; i < 256; i++) {
+					int key{key_distribution(rng)};
+					int operation{operation_distribution(rng)};
+					if (operation < search_percentage) {
+						l.search(key);
+					} else if ((operation - search_percentage) % 2 == 0) {
+						l.insert(key, key);
+					} else {
+						l.remove(key);
+					}
+				}
+				done += 256;
+			}
+			operations[t] = done;
+		});
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	start.store(true);
+	std::this_thread::sleep_for(std::chrono::seconds(1));
+	stop.store(true);
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+	long total{0};
+	for (long done : operations) {
+		total += done;
+	}
+	return total / elapsed.count();
+}
+
+/**
+ * @brief Runs pushes, each followed by a pop, with the given number of threads on a queue
+ *        prefilled with half the key range, for a fixed amount of time
+ *
+ * @param threads Number of threads
+ * @param keys Range of the priorities, twice the number of elements prefilled
+ * @param queue Which priority queue to run
+ * @param p Value of p for the Concurrent Priority Queue
+ * @return double Operations per second, counting pushes and pops
+ */
+static double run_queue(const int threads, const int keys, const Queue queue, const double p)
+{
+	DM803::ConcurrentPriorityQueue<int, int> concurrent(p);
+	std::priority_queue<int, std::vector<int>, std::greater<int>> heap;
+	std::mutex heap_mutex;
+
+	std::mt19937 prefill_rng(42);
+	std::uniform_int_distribution<> prefill_distribution(0, keys - 1);
+	for (int i = 0; i < keys / 2; i++) {
+		int priority{prefill_distribution(prefill_rng)};
+		if (queue == Queue::heap) {
+			heap.push(priority);
+		} else {
+			concurrent.push(priority, priority);
+		}
+	}
+
+	std::atomic<bool> start{false};
+	std::atomic<bool> stop{false};
+	std::vector<long> operations(threads);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t]() {
+			std::mt19937 rng(t + 1);
+			std::uniform_int_distribution<> priority_distribution(0, keys - 1);
+			while (!start.load()) {
+			}
+			long done{0};
+			while (!stop.load(std::memory_order_relaxed)) {
+				for (int i = 0; i < 256; i++) {
+					int priority{priority_distribution(rng)};
+					if (queue == Queue::heap) {
+						std::lock_guard<std::mutex> lock(heap_mutex);
+						heap.push(priority);
+						heap.pop();
+					} else {
+						concurrent.push(priority, priority);
+						if (queue == Queue::exact) {
+							concurrent.pop_min();
+						} else {
+							concurrent.pop_min_relaxed(threads);
+						}
+					}
+				}
+				done += 2 * 256;
+			}
+			operations[t] = done;
+		});
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	start.store(true);
+	std::this_thread::sleep_for(std::chrono::seconds(1));
+	stop.store(true);
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+	long total{0};
+	for (long done : operations) {
+		total += done;
+	}
+	return total / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+	int max_threads{static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))};
+	int keys{1000000};
+	int search_percentage{90};
+	double p{0.36788};
+	try {
+		if (argc > 1) {
+			max_threads = std::stoi(argv[1]);
+		}
+		if (argc > 2) {
+			keys = std::stoi(argv[2]);
+		}
+		if (argc > 3) {
+			search_percentage = std::stoi(argv[3]);
+		}
+		if (argc > 4) {
+			p = std::stod(argv[4]);
+		}
+	} catch (std::exception &e) {
+		max_threads = 0;
+	}
+	if (max_threads < 1 || keys < 2 || search_percentage < 0 || search_percentage > 100
+	    || p <= 0.0 || p >= 1.0) {
+		show_usage(argv[0]);
+		return 1;
+	}
+
+	std::cout << "keys = " << keys << ", searches = " << search_percentage << "%, p = " << p
+	          << std::endl;
+	std::cout << "threads\tops/s\t\tspeedup\tsharded ops/s\tspeedup" << std::endl;
+	double single{0.0};
+	double sharded_single{0.0};
+	for (int threads = 1; ; threads = std::min(2 * threads, max_threads)) {
+		DM803::ConcurrentSkipList<int, int> l(p);
+		double throughput{run(l, threads, keys, search_percentage)};
+		DM803::ShardedSkipList<int, int> sharded({}, DM803::ShardedSkipList<int, int>::MAX_SHARDS, p);
+		double sharded_throughput{run(sharded, threads, keys, search_percentage)};
+		if (threads == 1) {
+			single = throughput;
+			sharded_single = sharded_throughput;
+		}
+		std::cout << threads << "\t" << std::fixed << std::setprecision(0) << throughput << "\t"
+		          << std::setprecision(2) << throughput / single << "\t" << std::setprecision(0)
+		          << sharded_throughput << "\t" << std::setprecision(2)
+		          << sharded_throughput / sharded_single << std::endl;
+		if (threads == max_threads) {
+			break;
+		}
+	}
+
+	std::cout << "\npush and pop_min, " << keys / 2 << " elements" << std::endl;
+	std::cout << "threads\texact ops/s\trelaxed ops/s\theap ops/s" << std::endl;
+	for (int threads = 1; ; threads = std::min(2 * threads, max_threads)) {
+		std::cout << threads << std::fixed << std::setprecision(0);
+		for (Queue queue : {Queue::exact, Queue::relaxed, Queue::heap}) {
+			std::cout << "\t" << run_queue(threads, keys, queue, p);
+		}
+		std::cout << std::endl;
+		if (threads == max_threads) {
+			break;
+		}
+	}
+	return 0;
+}
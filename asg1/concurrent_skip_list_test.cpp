@@ -0,0 +1,513 @@
+/**
+ * @file concurrent_skip_list_test.cpp
+ * @brief Multi-threaded stress test for the lock-free Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Runs a number of threads against one shared Concurrent Skip List and checks that the final
+ * contents agree with the operations that reported success. Then does the same for the
+ * Concurrent Priority Queue built on it, checks that snapshots of the Mvcc Skip List see
+ * consistent views while writers change it, and last runs the churn again on the Sharded Skip
+ * List while it splits and merges its shards.
+ */
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_priority_queue.hpp"
+#include "concurrent_skip_list.hpp"
+#include "mvcc_skip_list.hpp"
+#include "sharded_skip_list.hpp"
+
+using List = DM803::ConcurrentSkipList<int, int>;
+
+/**
+ * @brief Prints a helper message to stdout for how to use this program
+ *
+ * @param program First argument from the command line, i.e. argv[0]
+ */
+static void show_usage(const std::string& program)
+{
+	std::cout << "Usage: " << program << " [<threads> [<operations per thread>]]\n"
+	          << "Arguments:\n"
+	          << "\tthreads\t\tOptional: Number of threads. Default value is the number of cores.\n"
+	          << "\toperations\tOptional: Operations per thread and phase. Default value is 100000.\n"
+	          << std::endl;
+}
+
+/**
+ * @brief Checks that the list is sorted and that its size matches the expected size
+ *
+ * @param l List to check
+ * @param expected_size Number of keys the list should hold
+ * @param phase Name of the phase, used in error messages
+ * @return bool True if the list passed the check
+ */
+template<class L>
+static bool check_list(L &l, const size_t expected_size, const std::string &phase)
+{
+	size_t visited{0};
+	bool sorted{true};
+	int previous{};
+	l.for_each([&](const int key, const int value) {
+		if ((visited > 0 && key <= previous) || value != key) {
+			sorted = false;
+		}
+		previous = key;
+		visited++;
+	});
+	if (!sorted || visited != expected_size || l.size() != expected_size) {
+		std::cout << "F - " << phase << ": expected " << expected_size << " keys in order, visited "
+		          << visited << (sorted ? " in order" : " out of order") << ", size() reports "
+		          << l.size() << std::endl;
+		return false;
+	}
+	std::cout << "S - " << phase << ": " << visited << " keys in order" << std::endl;
+	return true;
+}
+
+/**
+ * @brief Every thread inserts its own interleaved share of the keys, then searches for them
+ *
+ * @param threads Number of threads
+ * @param operations Keys inserted per thread
+ * @return bool True if the phase passed
+ */
+static bool disjoint_inserts(const int threads, const int operations)
+{
+	List l(0.5);
+	std::vector<int> failures(threads);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t]() {
+			for (int i = 0; i < operations; i++) {
+				int key{i * threads + t};
+				if (!l.insert(key, key)) {
+					failures[t]++;
+				}
+			}
+			for (int i = 0; i < operations; i++) {
+				int key{i * threads + t};
+				int value{};
+				if (!l.search(key, &value) || value != key) {
+					failures[t]++;
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	for (int t = 0; t < threads; t++) {
+		if (failures[t] > 0) {
+			std::cout << "F - disjoint inserts: thread " << t << " saw " << failures[t]
+			          << " failed operations" << std::endl;
+			return false;
+		}
+	}
+	return check_list(l, static_cast<size_t>(operations) * threads, "disjoint inserts");
+}
+
+/**
+ * @brief All threads insert, delete and search random keys from a small shared range, so that
+ *        most operations contend. Afterwards, every key must be present exactly if the number of
+ *        successful inserts of it exceeds the number of successful deletes by one
+ *
+ * @param threads Number of threads
+ * @param operations Operations per thread
+ * @return bool True if the phase passed
+ */
+static bool contended_churn(const int threads, const int operations)
+{
+	const int key_range{1024};
+	List l(0.5);
+	std::vector<std::vector<long>> balance(threads, std::vector<long>(key_range));
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t]() {
+			std::mt19937 rng(t + 1);
+			std::uniform_int_distribution<> key_distribution(0, key_range - 1);
+			std::uniform_int_distribution<> operation_distribution(0, 2);
+			for (int i = 0; i < operations; i++) {
+				int key{key_distribution(rng)};
+				switch (operation_distribution(rng)) {
+				case 0:
+					balance[t][key] += l.insert(key, key);
+					break;
+				case 1:
+					balance[t][key] -= l.remove(key);
+					break;
+				default:
+					l.search(key);
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	size_t expected_size{0};
+	for (int key = 0; key < key_range; key++) {
+		long net{0};
+		for (int t = 0; t < threads; t++) {
+			net += balance[t][key];
+		}
+		if (net != 0 && net != 1) {
+			std::cout << "F - contended churn: key '" << key << "' inserted " << net
+			          << " more times than deleted" << std::endl;
+			return false;
+		}
+		if (l.search(key) != (net == 1)) {
+			std::cout << "F - contended churn: key '" << key << "' should "
+			          << (net == 1 ? "" : "not ") << "be present" << std::endl;
+			return false;
+		}
+		expected_size += net;
+	}
+	return check_list(l, expected_size, "contended churn");
+}
+
+/**
+ * @brief Fills the list, then all threads race to delete every key. Each key must be deleted by
+ *        exactly one thread
+ *
+ * @param threads Number of threads
+ * @param operations Number of keys per thread
+ * @return bool True if the phase passed
+ */
+static bool racing_deletes(const int threads, const int operations)
+{
+	const int keys{operations * threads};
+	List l(0.5);
+	for (int key = 0; key < keys; key++) {
+		l.insert(key, key);
+	}
+	std::vector<long> deleted(threads);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t]() {
+			std::vector<int> order(keys);
+			std::iota(order.begin(), order.end(), 0);
+			std::shuffle(order.begin(), order.end(), std::mt19937(t + 1));
+			for (int key : order) {
+				deleted[t] += l.remove(key);
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	long total{0};
+	for (int t = 0; t < threads; t++) {
+		total += deleted[t];
+	}
+	if (total != keys) {
+		std::cout << "F - racing deletes: " << total << " successful deletes of " << keys
+		          << " keys" << std::endl;
+		return false;
+	}
+	return check_list(l, 0, "racing deletes");
+}
+
+/**
+ * @brief All threads push elements with random priorities from a small range and pop elements,
+ *        half of them with pop_min() and half with pop_min_relaxed(), after which the rest is
+ *        popped by one thread. Every element must be popped exactly once, and the single thread
+ *        must get them by priority, and in the order pushed among equal priorities
+ *
+ * @param threads Number of threads
+ * @param operations Elements pushed per thread
+ * @return bool True if the phase passed
+ */
+static bool priority_queue_pops(const int threads, const int operations)
+{
+	const int priority_range{64};
+	DM803::ConcurrentPriorityQueue<int, int> queue(0.5);
+	std::vector<int> popped(static_cast<size_t>(operations) * threads);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t]() {
+			std::mt19937 rng(t + 1);
+			std::uniform_int_distribution<> priority_distribution(0, priority_range - 1);
+			int value{};
+			for (int i = 0; i < operations; i++) {
+				queue.push(priority_distribution(rng), i * threads + t);
+				bool taken{t % 2 == 0 ? queue.pop_min(nullptr, &value)
+				                      : queue.pop_min_relaxed(threads, nullptr, &value)};
+				if (i % 2 == 0 && taken) {
+					popped[value]++;
+				} else if (taken) {
+					// Pushed back so that about half of the elements are left at the end
+					queue.push(priority_distribution(rng), value);
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	size_t left{queue.size()};
+	int priority{};
+	int value{};
+	int previous_priority{-1};
+	bool ordered{true};
+	for (size_t i = 0; i < left; i++) {
+		if (!queue.pop_min(&priority, &value)) {
+			ordered = false;
+			break;
+		}
+		ordered = ordered && priority >= previous_priority;
+		previous_priority = priority;
+		popped[value]++;
+	}
+	ordered = ordered && queue.empty() && !queue.pop_min();
+	size_t missing{static_cast<size_t>(std::count_if(popped.begin(), popped.end(), [](const int count) { return count != 1; }))};
+	if (!ordered || missing > 0) {
+		std::cout << "F - priority queue pops: " << missing << " elements not popped exactly once, "
+		          << (ordered ? "in order" : "out of order") << " when drained" << std::endl;
+		return false;
+	}
+
+	// Equal priorities come out in the order they were pushed
+	for (int i = 0; i < operations; i++) {
+		queue.push(i % 2, i);
+	}
+	for (int i = 0; i < operations; i++) {
+		queue.pop_min(&priority, &value);
+		int expected{i < (operations + 1) / 2 ? 2 * i : 2 * (i - (operations + 1) / 2) + 1};
+		if (value != expected) {
+			std::cout << "F - priority queue pops: popped '" << value << "' where '" << expected
+			          << "' was pushed first" << std::endl;
+			return false;
+		}
+	}
+	std::cout << "S - priority queue pops: " << popped.size() << " elements popped once, "
+	          << left << " of them in order" << std::endl;
+	return true;
+}
+
+/**
+ * @brief Half of the threads write rounds of values to their own keys, in ascending key order
+ *        and one write at a time, while also deleting and inserting other keys. The other threads
+ *        take snapshots and scan them. In a consistent view, the keys of each writer hold a
+ *        prefix of values from one round followed by values from the round before, and scanning
+ *        the same snapshot again gives the same pairs. Afterwards, collecting must leave one
+ *        version per key
+ *
+ * @param threads Number of threads
+ * @param operations Writes per writer thread
+ * @return bool True if the phase passed
+ */
+static bool snapshot_reads(const int threads, const int operations)
+{
+	const int writers{std::max(1, threads / 2)};
+	const int readers{std::max(1, threads - writers)};
+	const int keys_per_writer{64};
+	const int rounds{std::max(2, operations / (2 * keys_per_writer))};
+	const int round_keys{writers * keys_per_writer};
+	DM803::MvccSkipList<int, int> l(0.5);
+	for (int key = 0; key < round_keys; key++) {
+		l.insert(key, 0);
+	}
+	std::atomic<int> writing{writers};
+	std::vector<long> failures(readers);
+	std::vector<long> scans(readers);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < writers; t++) {
+		workers.emplace_back([&, t]() {
+			for (int round = 1; round <= rounds; round++) {
+				for (int key = t; key < round_keys; key += writers) {
+					l.insert_or_assign(key, round);
+					// Keys above the rounds come and go
+					int other{round_keys + (key + round) % round_keys};
+					if (!l.remove(other)) {
+						l.insert(other, round);
+					}
+				}
+			}
+			writing--;
+		});
+	}
+	for (int t = 0; t < readers; t++) {
+		workers.emplace_back([&, t]() {
+			while (writing > 0) {
+				auto snapshot = l.snapshot();
+				std::vector<std::pair<int, int>> pairs;
+				snapshot.for_each([&](const int key, const int value) { pairs.emplace_back(key, value); });
+				std::map<int, int> values(pairs.begin(), pairs.end());
+				for (int w = 0; w < writers; w++) {
+					int first{values[w]};
+					bool stepped{false};
+					for (int key = w; key < round_keys; key += writers) {
+						int value{values.count(key) > 0 ? values[key] : -1};
+						stepped = stepped || value == first - 1;
+						if (value != (stepped ? first - 1 : first)) {
+							failures[t]++;
+						}
+					}
+				}
+				std::vector<std::pair<int, int>> again;
+				snapshot.range_scan(0, 2 * round_keys, [&](const int key, const int value) { again.emplace_back(key, value); });
+				int value{};
+				int key{static_cast<int>(scans[t] % (2 * round_keys))};
+				if (again != pairs || snapshot.search(key, &value) != (values.count(key) > 0)
+				    || (values.count(key) > 0 && value != values[key])) {
+					failures[t]++;
+				}
+				scans[t]++;
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	for (int t = 0; t < readers; t++) {
+		if (failures[t] > 0) {
+			std::cout << "F - snapshot reads: reader " << t << " saw " << failures[t]
+			          << " inconsistent snapshots" << std::endl;
+			return false;
+		}
+	}
+	l.collect();
+	int value{};
+	for (int key = 0; key < round_keys; key++) {
+		if (!l.search(key, &value) || value != rounds) {
+			std::cout << "F - snapshot reads: key '" << key << "' does not hold the last round" << std::endl;
+			return false;
+		}
+	}
+	if (l.versions() != l.size()) {
+		std::cout << "F - snapshot reads: " << l.versions() << " versions kept for " << l.size()
+		          << " keys after collecting" << std::endl;
+		return false;
+	}
+	long total{0};
+	for (long count : scans) {
+		total += count;
+	}
+	std::cout << "S - snapshot reads: " << total << " consistent snapshots, " << l.size()
+	          << " keys with one version each" << std::endl;
+	return true;
+}
+
+/**
+ * @brief All threads insert, delete and search random keys, most of them in a hot range that
+ *        moves halfway through, so that shards are split and merged while they run, and one
+ *        thread also checks that range scans come out in order and, unless the run is too
+ *        short, that the single shard the list starts with is split. Afterwards, every key must be present exactly if the number
+ *        of successful inserts of it exceeds the number of successful deletes by one
+ *
+ * @param threads Number of threads
+ * @param operations Operations per thread
+ * @return bool True if the phase passed
+ */
+static bool sharded_churn(const int threads, const int operations)
+{
+	const int key_range{1 << 16};
+	using Sharded = DM803::ShardedSkipList<int, int>;
+	Sharded l({}, 8);
+	std::vector<std::vector<long>> balance(threads, std::vector<long>(key_range));
+	std::vector<long> unordered_scans(threads);
+	const size_t initial_shards{l.shards()};
+	size_t most_shards{initial_shards};
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t]() {
+			std::mt19937 rng(t + 1);
+			std::uniform_int_distribution<> key_distribution(0, key_range - 1);
+			std::uniform_int_distribution<> hot_distribution(0, key_range / 16 - 1);
+			std::uniform_int_distribution<> operation_distribution(0, 2);
+			for (int i = 0; i < operations; i++) {
+				int hot_start{i < operations / 2 ? 0 : key_range / 2};
+				int key{i % 4 == 0 ? key_distribution(rng) : hot_start + hot_distribution(rng)};
+				switch (operation_distribution(rng)) {
+				case 0:
+					balance[t][key] += l.insert(key, key);
+					break;
+				case 1:
+					balance[t][key] -= l.remove(key);
+					break;
+				default:
+					l.search(key);
+				}
+				if (t == 0 && i % 1024 == 0) {
+					int previous{-1};
+					l.range_scan(key, key + key_range / 4, [&](const int found, const int value) {
+						unordered_scans[t] += found <= previous || value != found;
+						previous = found;
+					});
+					most_shards = std::max(most_shards, l.shards());
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	most_shards = std::max(most_shards, l.shards());
+	if (unordered_scans[0] > 0) {
+		std::cout << "F - sharded churn: " << unordered_scans[0] << " range scans out of order" << std::endl;
+		return false;
+	}
+	// Two thirds of the operations are writes, and a shard is only checked every REBALANCE_INTERVAL
+	// writes to it, so too short a run may not get to split it
+	const bool enough_writes{static_cast<size_t>(threads) * operations >= 4 * Sharded::REBALANCE_INTERVAL};
+	if (enough_writes && most_shards == initial_shards) {
+		std::cout << "F - sharded churn: never split its " << initial_shards << " shard(s)" << std::endl;
+		return false;
+	}
+	size_t expected_size{0};
+	for (int key = 0; key < key_range; key++) {
+		long net{0};
+		for (int t = 0; t < threads; t++) {
+			net += balance[t][key];
+		}
+		if ((net != 0 && net != 1) || l.search(key) != (net == 1)) {
+			std::cout << "F - sharded churn: key '" << key << "' inserted " << net
+			          << " more times than deleted, but " << (l.search(key) ? "" : "not ")
+			          << "present" << std::endl;
+			return false;
+		}
+		expected_size += net;
+	}
+	return check_list(l, expected_size, "sharded churn (up to " + std::to_string(most_shards) + " shards)");
+}
+
+int main(int argc, char *argv[])
+{
+	int threads{static_cast<int>(std::max(2u, std::thread::hardware_concurrency()))};
+	int operations{100000};
+	try {
+		if (argc > 1) {
+			threads = std::stoi(argv[1]);
+		}
+		if (argc > 2) {
+			operations = std::stoi(argv[2]);
+		}
+	} catch (std::exception &e) {
+		threads = 0;
+	}
+	if (threads < 1 || operations < 1) {
+		show_usage(argv[0]);
+		return 1;
+	}
+
+	std::cout << "Stress testing Concurrent Skip List with " << threads << " threads and "
+	          << operations << " operations per thread" << std::endl;
+	bool passed{disjoint_inserts(threads, operations)};
+	passed = contended_churn(threads, operations) && passed;
+	passed = racing_deletes(threads, operations / 10 + 1) && passed;
+	passed = priority_queue_pops(threads, operations) && passed;
+	passed = snapshot_reads(threads, operations) && passed;
+	passed = sharded_churn(threads, operations) && passed;
+	return passed ? 0 : 1;
+}
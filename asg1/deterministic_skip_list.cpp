@@ -0,0 +1,70 @@
+/**
+ * @file deterministic_skip_list.cpp
+ * @brief Test program for the deterministic 1-2-3 Skip List data structure
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Test program for the 1-2-3 Skip List data structure, based on the paper by Munro, Papadakis and
+ * Sedgewick, reading insert, search and delete commands from stdin in the same format as the Skip
+ * List test program. The Deterministic Skip List itself is in deterministic_skip_list.hpp.
+ */
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "deterministic_skip_list.hpp"
+
+int main()
+{
+	DM803::DeterministicSkipList<int, int> l;
+
+	std::string line{};
+	std::string space_delimiter{" "};
+	std::string operation{};
+	int key{};
+
+	while(std::getline(std::cin, line)) {
+		operation = line.substr(0, line.find(space_delimiter));
+		try {
+			key = std::stoi(line.substr(line.find(space_delimiter) + space_delimiter.length()));
+		} catch (std::invalid_argument &e) {
+			key = -1;
+		}
+		if (operation == "I" || operation == "i") {
+			std::pair<int, bool> inserted(l.insert(key, key));
+			if (inserted.second) {
+				std::cout << "S - inserted '" << key << "'. Comparisons: " << inserted.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			} else {
+				std::cout << "F - key '" << key << "' already present. Comparisons: " << inserted.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			}
+		} else if (operation == "S" || operation == "s") {
+			std::pair<int, bool> key_found(l.search(key));
+			if (key_found.second) {
+				std::cout << "S - found '" << key << "'. Comparisons: " << key_found.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			} else {
+				std::cout << "F - key '" << key << "' not present. Comparisons: " << key_found.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			}
+		} else if (operation == "D" || operation == "d") {
+			std::pair<int, bool> removed(l.remove(key));
+			if (removed.second) {
+				std::cout << "S - deleted '" << key << "'. Comparisons: " << removed.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			} else {
+				std::cout << "F - key '" << key << "' not present. Comparisons: " << removed.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			}
+		} else if (operation == "Q" || operation == "q") {
+			return 0;
+		} else {
+			std::cout << "F - " << operation << " command unknown, ignored" << std::endl;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,424 @@
+/**
+ * @file deterministic_skip_list.hpp
+ * @brief Header-only implementation of the deterministic 1-2-3 Skip List data structure
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Implementation of the 1-2-3 Skip List by Munro, Papadakis and Sedgewick, an ordered map with the
+ * same search, insert and delete interface as the Skip List, but without randomisation. Between
+ * any two consecutive elements of height h or more there are always 1, 2 or 3 elements of height
+ * exactly h - 1, so every level holds at most half the nodes of the level below it. The height is
+ * therefore at most log(n) + 1, and a search makes at most 3 comparisons per level, giving worst
+ * case rather than expected O(log n) bounds.
+ *
+ * The levels are stored as linked lists as in [2]. A node at level h has a down pointer to the
+ * first node of its gap at level h - 1, and the gap ends with the node for the same element at
+ * level h - 1. The key and value of an element are kept in a separate entry shared by all of its
+ * nodes, so promoting, demoting and moving elements between gaps only moves entry pointers, and
+ * a pointer to a value stays valid until its key is deleted. The last node of every level stands
+ * for +infinity and has no entry.
+ *
+ * Insertion splits every full gap (3 elements) on the way down, so the gap the new element ends
+ * up in has room for it. Deletion makes sure every gap it descends into has at least 2 elements,
+ * by borrowing an element from a neighbouring gap or merging with it, so removing one element
+ * never leaves a gap empty.
+ *
+ * References:
+ * [1] J. Ian Munro, Thomas Papadakis and Robert Sedgewick. Deterministic Skip Lists. In
+ *     Proceedings of the Third Annual ACM-SIAM Symposium on Discrete Algorithms, 367-375, 1992.
+ * [2] Mark Allen Weiss. Data Structures and Algorithm Analysis in C++, 3rd edition, section 12.4.
+ *     Addison-Wesley, 2006.
+ */
+#ifndef DETERMINISTIC_SKIP_LIST_HPP
+#define DETERMINISTIC_SKIP_LIST_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <utility>
+
+namespace DM803
+{
+template<class Key, class Value, class Compare = std::less<Key>>
+class DeterministicSkipList
+{
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using value_type = std::pair<const Key, Value>;
+	using key_compare = Compare;
+	using size_type = std::size_t;
+
+	/**
+	 * @brief Constructs a new empty Deterministic Skip List object
+	 *
+	 * @param comp Comparator defining the order of the keys
+	 */
+	explicit DeterministicSkipList(const Compare &comp=Compare())
+		: list_size(0),
+		  list_height(1),
+		  comp(comp),
+		  header(new Node{nullptr, nullptr, nullptr})
+	{
+	}
+
+	DeterministicSkipList(const DeterministicSkipList &) = delete;
+	DeterministicSkipList &operator=(const DeterministicSkipList &) = delete;
+
+	/**
+	 * @brief Destroys the Deterministic Skip List object
+	 *
+	 */
+	~DeterministicSkipList()
+	{
+		for (Node *level = header; level != nullptr; ) {
+			Node *down = level->down;
+			for (Node *node = level; node != nullptr; ) {
+				Node *right = node->right;
+				if (down == nullptr) {
+					delete node->entry;
+				}
+				delete node;
+				node = right;
+			}
+			level = down;
+		}
+	}
+
+	/**
+	 * @brief Searches the Deterministic Skip List for the given key
+	 *
+	 * @param search_key Key to find
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was found, false otherwise
+	 */
+	std::pair<int, bool> search(const Key &search_key) const
+	{
+		int comparisons{0};
+		const Node *node = header;
+		for (;;) {
+			while (less(node, search_key, comparisons)) {
+				node = node->right;
+			}
+			if (node->down == nullptr) {
+				return std::make_pair(comparisons, equal(node, search_key, comparisons));
+			}
+			node = node->down;
+		}
+	}
+
+	/**
+	 * @brief Looks up the value stored for the given key
+	 *
+	 * @param search_key Key to find
+	 * @return Value* Pointer to the value, or null if the key is not present
+	 */
+	Value *get(const Key &search_key) const
+	{
+		int comparisons{0};
+		const Node *node = header;
+		for (;;) {
+			while (less(node, search_key, comparisons)) {
+				node = node->right;
+			}
+			if (node->down == nullptr) {
+				return equal(node, search_key, comparisons) ? &node->entry->second : nullptr;
+			}
+			node = node->down;
+		}
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Deterministic Skip List
+	 *
+	 * @param search_key Key to insert
+	 * @param new_value Value to insert
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key and value was inserted,
+	 * 									    false otherwise (e.g. key already present)
+	 */
+	std::pair<int, bool> insert(const Key &search_key, const Value &new_value)
+	{
+		int comparisons{0};
+		Node *node = header;
+		for (;;) {
+			while (less(node, search_key, comparisons)) {
+				node = node->right;
+			}
+			if (node->down == nullptr) {
+				break;
+			}
+			// Split a full gap by raising its middle element to this level. The node keeps the
+			// first half of the gap, so the search continues from it at this level
+			Node *second = node->down->right;
+			if (second->entry != node->entry && second->right->entry != node->entry) {
+				node->right = new Node{node->entry, node->right, second->right};
+				node->entry = second->entry;
+			} else {
+				node = node->down;
+			}
+		}
+		if (equal(node, search_key, comparisons)) {
+			grow();
+			return std::make_pair(comparisons, false);
+		}
+		// The node moves its entry to a new node after it and takes the new entry instead, so the
+		// node above that ends the gap keeps pointing to the end of the gap
+		node->right = new Node{node->entry, node->right, nullptr};
+		node->entry = new value_type(search_key, new_value);
+		list_size++;
+		grow();
+		return std::make_pair(comparisons, true);
+	}
+
+	/**
+	 * @brief Deletes the key, if present, from the Deterministic Skip List
+	 *
+	 * @param search_key Key to be deleted
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was found and deleted, false otherwise
+	 */
+	std::pair<int, bool> remove(const Key &search_key)
+	{
+		// Nodes passed on the way down, at most one per level above the bottom
+		Node *path[MAX_HEIGHT];
+		size_t path_length{0};
+
+		int comparisons{0};
+		Node *node = header;
+		Node *previous = nullptr;
+		const value_type *gap_end = nullptr;
+		for (;;) {
+			while (less(node, search_key, comparisons)) {
+				previous = node;
+				node = node->right;
+			}
+			if (node->down == nullptr) {
+				break;
+			}
+			// The gap below the single node of the top level may shrink to nothing, which removes
+			// the top level afterwards
+			if (node != header && node->down->right->entry == node->entry) {
+				node = widen_gap(node, previous, gap_end);
+			}
+			path[path_length++] = node;
+			gap_end = node->entry;
+			previous = nullptr;
+			node = node->down;
+		}
+
+		if (!equal(node, search_key, comparisons)) {
+			shrink();
+			return std::make_pair(comparisons, false);
+		}
+		value_type *entry = node->entry;
+		if (entry == gap_end) {
+			// The element is taller than one level. Its predecessor in the gap takes its place on
+			// every level above
+			for (size_t i = 0; i < path_length; i++) {
+				if (path[i]->entry == entry) {
+					path[i]->entry = previous->entry;
+				}
+			}
+			previous->right = node->right;
+			delete node;
+		} else {
+			Node *next = node->right;
+			node->entry = next->entry;
+			node->right = next->right;
+			delete next;
+		}
+		delete entry;
+		list_size--;
+		shrink();
+		return std::make_pair(comparisons, true);
+	}
+
+	/**
+	 * @brief Returns the number of elements in the Deterministic Skip List
+	 *
+	 * @return size_t
+	 */
+	size_t size() const
+	{
+		return list_size;
+	}
+
+	bool empty() const
+	{
+		return list_size == 0;
+	}
+
+	/**
+	 * @brief Returns the number of levels holding elements, which is at most log(n) + 1. The top
+	 *        level, which only holds +infinity, is not counted
+	 *
+	 * @return int
+	 */
+	int height() const
+	{
+		return list_height - 1;
+	}
+
+	key_compare key_comp() const
+	{
+		return comp;
+	}
+
+	/**
+	 * @brief Allows printing of the keys of the Deterministic Skip List
+	 *
+	 * @param s Reference to output stream
+	 * @param l Deterministic Skip List to print
+	 * @return std::ostream& Reference to output stream
+	 */
+	friend std::ostream &operator<<(std::ostream &s, const DeterministicSkipList &l)
+	{
+		const Node *node = l.header;
+		while (node->down != nullptr) {
+			node = node->down;
+		}
+		for (; node->entry != nullptr; node = node->right) {
+			s << "[" << node->entry->first << "]";
+			if (node->right->entry != nullptr) {
+				s << "->";
+			}
+		}
+		return s;
+	}
+
+private:
+	// Upper bound for the height, as every level has at most half the nodes of the level below
+	static constexpr size_t MAX_HEIGHT{8 * sizeof(size_t) + 2};
+
+	struct Node
+	{
+		// Key and value of the element, or null for +infinity
+		value_type *entry;
+
+		Node *right;
+
+		// First node of the gap below, or null at the bottom level
+		Node *down;
+	};
+
+	/**
+	 * @brief Compares the key of a node to a search key, where +infinity orders after every key
+	 *
+	 * @param node Node to compare
+	 * @param search_key Key to compare against
+	 * @param comparisons Number of comparisons, incremented if a comparison is made
+	 * @return bool True if the key of the node orders before the search key
+	 */
+	bool less(const Node *node, const Key &search_key, int &comparisons) const
+	{
+		if (node->entry == nullptr) {
+			return false;
+		}
+		comparisons++;
+		return comp(node->entry->first, search_key);
+	}
+
+	/**
+	 * @brief Checks if the key of a node, known not to order before the search key, equals it
+	 *
+	 * @param node Node to compare
+	 * @param search_key Key to compare against
+	 * @param comparisons Number of comparisons, incremented if a comparison is made
+	 * @return bool True if the key of the node is equivalent to the search key
+	 */
+	bool equal(const Node *node, const Key &search_key, int &comparisons) const
+	{
+		if (node->entry == nullptr) {
+			return false;
+		}
+		comparisons++;
+		return !comp(search_key, node->entry->first);
+	}
+
+	/**
+	 * @brief Gives the gap below a node with a single element a second one, by borrowing an
+	 *        element from the gap of a neighbouring node at the same level, or merging the two
+	 *        gaps if the neighbour only has one as well
+	 *
+	 * The neighbour is the next node if the node does not end the gap it is in itself, and the
+	 * previous node otherwise. The gap the node is in has at least two elements, unless it is at
+	 * the top level, so merging keeps it from becoming empty.
+	 *
+	 * @param node Node whose gap has a single element
+	 * @param previous Node before it at the same level, or null if it is first in its gap
+	 * @param gap_end Entry of the node ending the gap the node is in
+	 * @return Node* Node to descend from, which is the previous node after merging with it
+	 */
+	Node *widen_gap(Node *node, Node *previous, const value_type *gap_end)
+	{
+		if (node->entry != gap_end) {
+			Node *next = node->right;
+			Node *first = next->down;
+			if (first->right->entry != next->entry) {
+				node->entry = first->entry;
+				next->down = first->right;
+			} else {
+				node->entry = next->entry;
+				node->right = next->right;
+				delete next;
+			}
+			return node;
+		}
+		Node *last = previous->down;
+		if (last->right->entry != previous->entry) {
+			while (last->right->entry != previous->entry) {
+				last = last->right;
+			}
+			previous->entry = last->entry;
+			node->down = last->right;
+			return node;
+		}
+		previous->entry = node->entry;
+		previous->right = node->right;
+		delete node;
+		return previous;
+	}
+
+	/**
+	 * @brief Adds a new top level once the top level holds more than one node
+	 *
+	 */
+	void grow()
+	{
+		if (header->right != nullptr) {
+			header = new Node{nullptr, nullptr, header};
+			list_height++;
+		}
+	}
+
+	/**
+	 * @brief Removes the top level once the level below it holds only the node for +infinity
+	 *
+	 */
+	void shrink()
+	{
+		while (header->down != nullptr && header->down->right == nullptr) {
+			Node *top = header;
+			header = header->down;
+			delete top;
+			list_height--;
+		}
+	}
+
+	size_t list_size{};
+
+	// Number of levels, including the bottom level
+	int list_height{};
+
+	Compare comp;
+
+	// Single node of the top level, standing for +infinity
+	Node *header;
+};
+} // namespace DM803
+
+#endif // DETERMINISTIC_SKIP_LIST_HPP
@@ -0,0 +1,288 @@
+/**
+ * @file epoch_reclamation.hpp
+ * @brief Epoch-based memory reclamation for lock-free data structures
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Epoch-based reclamation in the style of Fraser. Threads pin the current global epoch while they
+ * hold pointers into a shared structure, and objects that have been unlinked are retired instead
+ * of freed. A retired object is tagged with the global epoch at the time of retirement and is only
+ * reclaimed once the global epoch has advanced twice past that tag, at which point no thread that
+ * could have seen the object can still be pinned.
+ *
+ * References:
+ * [1] Keir Fraser. Practical lock-freedom. PhD thesis, University of Cambridge, 2004.
+ */
+#ifndef EPOCH_RECLAMATION_HPP
+#define EPOCH_RECLAMATION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace DM803
+{
+class EpochManager
+{
+	struct ThreadRecord;
+
+public:
+	/**
+	 * RAII handle keeping the calling thread pinned in the current epoch. Pins nest, so a thread
+	 * that is already pinned may pin again.
+	 */
+	class Guard
+	{
+	public:
+		explicit Guard(EpochManager &manager)
+			: manager(&manager),
+			  record(manager.enter())
+		{
+		}
+
+		Guard(const Guard &) = delete;
+		Guard &operator=(const Guard &) = delete;
+
+		~Guard()
+		{
+			manager->leave(record);
+		}
+
+	private:
+		EpochManager *manager;
+		ThreadRecord *record;
+	};
+
+	/**
+	 * @brief Constructs a new Epoch Manager object
+	 *
+	 */
+	EpochManager()
+		: id(next_manager_id().fetch_add(1))
+	{
+	}
+
+	EpochManager(const EpochManager &) = delete;
+	EpochManager &operator=(const EpochManager &) = delete;
+
+	/**
+	 * @brief Destroys the Epoch Manager object, reclaiming everything still retired
+	 *
+	 * No thread may be pinned when the manager is destroyed.
+	 */
+	~EpochManager()
+	{
+		ThreadRecord *record = records.load();
+		while (record != nullptr) {
+			for (Retired &retired : record->limbo) {
+				retired.reclaim(retired.object);
+			}
+			ThreadRecord *next = record->next;
+			delete record;
+			record = next;
+		}
+	}
+
+	/**
+	 * @brief Pins the calling thread in the current epoch for the lifetime of the returned guard
+	 *
+	 * @return Guard Handle that unpins the thread when destroyed
+	 */
+	Guard pin()
+	{
+		return Guard(*this);
+	}
+
+	/**
+	 * @brief Retires an object that is no longer reachable from the shared structure
+	 *
+	 * The calling thread must be pinned. The object is reclaimed by calling reclaim(object) once
+	 * no thread can still hold a reference to it.
+	 *
+	 * @param object Object to retire
+	 * @param reclaim Function releasing the object
+	 */
+	void retire(void *object, void (*reclaim)(void *))
+	{
+		ThreadRecord *record = local_record();
+		record->limbo.push_back(Retired{object, reclaim, global_epoch.load()});
+		if (++record->retired_since_collect >= COLLECT_THRESHOLD) {
+			record->retired_since_collect = 0;
+			try_advance();
+			collect(record);
+		}
+	}
+
+private:
+	// Number of retirements between attempts to advance the epoch and reclaim memory
+	static constexpr std::size_t COLLECT_THRESHOLD{64};
+
+	// Local epoch of a thread that is not pinned
+	static constexpr std::uint64_t INACTIVE{0};
+
+	// Least size of a thread's record cache at which the entries of destroyed managers are dropped
+	static constexpr std::size_t CACHE_PRUNE_SIZE{16};
+
+	struct Retired
+	{
+		void *object;
+		void (*reclaim)(void *);
+		std::uint64_t epoch;
+	};
+
+	struct alignas(64) ThreadRecord
+	{
+		// Epoch the thread is pinned in, or INACTIVE
+		std::atomic<std::uint64_t> epoch{INACTIVE};
+
+		// Depth of nested pins, only touched by the owning thread
+		unsigned nesting{0};
+
+		// Retired objects in nondecreasing epoch order, only touched by the owning thread
+		std::deque<Retired> limbo;
+		std::size_t retired_since_collect{0};
+
+		ThreadRecord *next{nullptr};
+	};
+
+	struct CachedRecord
+	{
+		std::uint64_t manager_id;
+		ThreadRecord *record;
+
+		// Expires when the manager is destroyed
+		std::weak_ptr<const char> alive;
+	};
+
+	/**
+	 * @brief Source of unique manager ids, so a thread's record cache never confuses a destroyed
+	 *        manager with a new one allocated at the same address
+	 *
+	 * @return std::atomic<std::uint64_t>& Next unused id
+	 */
+	static std::atomic<std::uint64_t> &next_manager_id()
+	{
+		static std::atomic<std::uint64_t> id{0};
+		return id;
+	}
+
+	/**
+	 * @brief Finds the record of the calling thread, registering a new one on first use
+	 *
+	 * Records are never unregistered and live until the manager is destroyed, so a thread that
+	 * exits simply leaves an inactive record behind. Whenever the cache of the thread has doubled
+	 * since it was last pruned, the entries of managers destroyed since are dropped, so a thread
+	 * using many short-lived managers keeps a cache in proportion to the ones still alive.
+	 *
+	 * @return ThreadRecord* Record of the calling thread
+	 */
+	ThreadRecord *local_record()
+	{
+		thread_local std::vector<CachedRecord> cache;
+		thread_local std::size_t prune_at{CACHE_PRUNE_SIZE};
+		for (const CachedRecord &cached : cache) {
+			if (cached.manager_id == id) {
+				return cached.record;
+			}
+		}
+		if (cache.size() >= prune_at) {
+			cache.erase(std::remove_if(cache.begin(), cache.end(), [](const CachedRecord &cached) {
+				return cached.alive.expired();
+			}), cache.end());
+			prune_at = std::max(CACHE_PRUNE_SIZE, 2 * cache.size());
+		}
+		ThreadRecord *record = new ThreadRecord;
+		record->next = records.load();
+		while (!records.compare_exchange_weak(record->next, record)) {
+		}
+		cache.push_back(CachedRecord{id, record, alive});
+		return record;
+	}
+
+	/**
+	 * @brief Pins the calling thread in the current global epoch
+	 *
+	 * @return ThreadRecord* Record of the calling thread
+	 */
+	ThreadRecord *enter()
+	{
+		ThreadRecord *record = local_record();
+		if (record->nesting++ == 0) {
+			std::uint64_t epoch{global_epoch.load()};
+			// Sequentially consistent store and load, so a thread advancing the epoch either sees
+			// this thread as pinned or this thread sees the advanced epoch
+			for (;;) {
+				record->epoch.store(epoch);
+				std::uint64_t now{global_epoch.load()};
+				if (now == epoch) {
+					break;
+				}
+				epoch = now;
+			}
+			collect(record);
+		}
+		return record;
+	}
+
+	/**
+	 * @brief Unpins the calling thread once its outermost guard is destroyed
+	 *
+	 * @param record Record of the calling thread
+	 */
+	void leave(ThreadRecord *record)
+	{
+		if (--record->nesting == 0) {
+			record->epoch.store(INACTIVE, std::memory_order_release);
+		}
+	}
+
+	/**
+	 * @brief Advances the global epoch if every pinned thread has observed the current one
+	 *
+	 */
+	void try_advance()
+	{
+		std::uint64_t epoch{global_epoch.load()};
+		for (ThreadRecord *record = records.load(); record != nullptr; record = record->next) {
+			std::uint64_t local{record->epoch.load()};
+			if (local != INACTIVE && local != epoch) {
+				return;
+			}
+		}
+		global_epoch.compare_exchange_strong(epoch, epoch + 1);
+	}
+
+	/**
+	 * @brief Reclaims the objects retired by the calling thread at least two epochs ago
+	 *
+	 * @param record Record of the calling thread
+	 */
+	void collect(ThreadRecord *record)
+	{
+		std::uint64_t epoch{global_epoch.load()};
+		while (!record->limbo.empty() && record->limbo.front().epoch + 2 <= epoch) {
+			Retired retired{record->limbo.front()};
+			record->limbo.pop_front();
+			retired.reclaim(retired.object);
+		}
+	}
+
+	const std::uint64_t id;
+
+	// Owned by the manager alone, so the record caches of threads can tell when it is destroyed
+	const std::shared_ptr<const char> alive{std::make_shared<const char>()};
+
+	// Epochs start at 1, since 0 marks a thread that is not pinned
+	std::atomic<std::uint64_t> global_epoch{1};
+
+	std::atomic<ThreadRecord *> records{nullptr};
+};
+} // namespace DM803
+
+#endif // EPOCH_RECLAMATION_HPP
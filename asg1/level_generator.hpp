@@ -0,0 +1,165 @@
+/**
+ * @file level_generator.hpp
+ * @brief Random level generation for the Skip Lists from a single 64 bit draw
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * The level of a new node is geometrically distributed, being i or more with probability
+ * p^(i-1). Rather than drawing one random double per level until the draw fails, the level is
+ * read off a single 64 bit number from the small xoshiro256** engine. For p = 2^-k, each run of k
+ * trailing zero bits is one level more. For other values of p, the number is compared against a
+ * table of the thresholds p^i * 2^64, worked out once when the list is made, which is the inverse
+ * of the distribution function.
+ *
+ * References:
+ * [1] David Blackman and Sebastiano Vigna. Scrambled linear pseudorandom number generators.
+ *     ACM Transactions on Mathematical Software 47(4), 2021.
+ */
+#ifndef LEVEL_GENERATOR_HPP
+#define LEVEL_GENERATOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace DM803
+{
+/**
+ * xoshiro256** engine, with 32 bytes of state and meeting the requirements of a uniform random
+ * bit generator
+ */
+class Xoshiro256
+{
+public:
+	using result_type = std::uint64_t;
+
+	/**
+	 * @brief Constructs a new Xoshiro256 object, filling the state from the seed with splitmix64
+	 *        as recommended by the authors
+	 *
+	 * @param seed Seed
+	 */
+	explicit Xoshiro256(std::uint64_t seed)
+	{
+		for (std::uint64_t &word : state) {
+			seed += 0x9e3779b97f4a7c15;
+			std::uint64_t z{seed};
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+			word = z ^ (z >> 31);
+		}
+	}
+
+	static constexpr result_type min()
+	{
+		return 0;
+	}
+
+	static constexpr result_type max()
+	{
+		return std::numeric_limits<result_type>::max();
+	}
+
+	result_type operator()()
+	{
+		const std::uint64_t result{rotl(state[1] * 5, 7) * 9};
+		const std::uint64_t t{state[1] << 17};
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 45);
+		return result;
+	}
+
+private:
+	static std::uint64_t rotl(const std::uint64_t x, const int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	std::uint64_t state[4];
+};
+
+/**
+ * Geometric distribution of node levels for a given p, capped at a level cap
+ */
+class GeometricLevels
+{
+public:
+	// Largest supported level cap
+	static constexpr int MAX_LEVEL_CAP{64};
+
+	/**
+	 * @brief Constructs a new Geometric Levels object
+	 *
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater
+	 * @param level_cap Largest level to generate, at most MAX_LEVEL_CAP
+	 */
+	GeometricLevels(const double p, const int level_cap)
+		: level_cap(std::max(1, std::min(level_cap, MAX_LEVEL_CAP)))
+	{
+		int exponent{};
+		if (std::frexp(p, &exponent) == 0.5 && exponent <= 0) {
+			bits_per_level = 1 - exponent;
+		}
+		// thresholds[i] is p^(i+1) * 2^64, so a draw below it has a level above i + 1
+		double threshold{p * 18446744073709551616.0};
+		for (int i = 0; i < MAX_LEVEL_CAP; i++) {
+			thresholds[i] = threshold >= 18446744073709551616.0 ? MAX_DRAW : static_cast<std::uint64_t>(threshold);
+			threshold *= p;
+		}
+	}
+
+	/**
+	 * @brief Draws a level
+	 *
+	 * @param engine Engine producing uniformly random 64 bit numbers
+	 * @return int Positive integer in range [1,level cap]
+	 */
+	template<class Engine>
+	int operator()(Engine &engine) const
+	{
+		const std::uint64_t draw{engine()};
+		int level{1};
+		if (bits_per_level > 0) {
+			level += draw == 0 ? 64 / bits_per_level : count_trailing_zeros(draw) / bits_per_level;
+			return std::min(level, level_cap);
+		}
+		while (level < level_cap && draw < thresholds[level-1]) {
+			level++;
+		}
+		return level;
+	}
+
+private:
+	static int count_trailing_zeros(const std::uint64_t x)
+	{
+#if defined(__GNUC__)
+		return __builtin_ctzll(x);
+#else
+		int count{0};
+		for (std::uint64_t y = x; (y & 1) == 0; y >>= 1) {
+			count++;
+		}
+		return count;
+#endif
+	}
+
+	static constexpr std::uint64_t MAX_DRAW{std::numeric_limits<std::uint64_t>::max()};
+
+	int level_cap{};
+
+	// k if p = 2^-k, otherwise 0 to use the thresholds
+	int bits_per_level{0};
+
+	std::uint64_t thresholds[MAX_LEVEL_CAP];
+};
+} // namespace DM803
+
+#endif // LEVEL_GENERATOR_HPP
@@ -0,0 +1,126 @@
+/**
+ * @file level_generator_bench.cpp
+ * @brief Benchmark and distribution check for the random level generation of the Skip Lists
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * For a few values of p, times drawing levels one double per level from a std::mt19937, as the
+ * Skip Lists used to, against drawing them from one 64 bit number with level_generator.hpp, and
+ * prints the mean level drawn by each, which should be 1/(1-p). It then checks, for as many draws as
+ * a list of the given size has nodes, that the fraction of levels i or greater stays at p^(i-1),
+ * and that the highest level drawn is close to L(n).
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "level_generator.hpp"
+
+/**
+ * @brief Prints a helper message to stdout for how to use this program
+ *
+ * @param program First argument from the command line, i.e. argv[0]
+ */
+static void show_usage(const std::string& program)
+{
+	std::cout << "Usage: " << program << " [<draws> [<keys>]]\n"
+	          << "Arguments:\n"
+	          << "\tdraws\t\tOptional: Number of levels to draw for the timings. Default value is 10000000.\n"
+	          << "\tkeys\t\tOptional: Size of the list to check the distribution for. Default value is 1000000.\n"
+	          << std::endl;
+}
+
+/**
+ * @brief Draws levels and returns the time per level, adding up the levels so that the work is
+ *        not optimised away
+ *
+ * @param draws Number of levels to draw
+ * @param draw Callback returning one level
+ * @param sum Receives the sum of the levels
+ * @return double Nanoseconds per level
+ */
+template<class Draw>
+static double time_draws(const long draws, Draw draw, long &sum)
+{
+	auto begin = std::chrono::steady_clock::now();
+	sum = 0;
+	for (long i = 0; i < draws; i++) {
+		sum += draw();
+	}
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+	return elapsed.count() / draws;
+}
+
+int main(int argc, char *argv[])
+{
+	long draws{10000000};
+	long keys{1000000};
+	try {
+		if (argc > 1) {
+			draws = std::stol(argv[1]);
+		}
+		if (argc > 2) {
+			keys = std::stol(argv[2]);
+		}
+	} catch (std::exception &e) {
+		draws = 0;
+	}
+	if (draws < 1 || keys < 2) {
+		show_usage(argv[0]);
+		return 1;
+	}
+
+	const int level_cap{32};
+	std::cout << "p\tmt19937 ns\tgenerator ns\tmean levels\t\tlevels\tL(n)\tworst error of P(level >= i)"
+	          << std::endl;
+	for (double p : {0.5, 0.25, 0.36788, 0.3}) {
+		std::mt19937 mt(42);
+		std::uniform_real_distribution<> uniform_zero_one_distribution(0.0, 1.0);
+		long mt_sum{};
+		double mt_time{time_draws(draws, [&]() {
+			int level{1};
+			while (uniform_zero_one_distribution(mt) < p && level < level_cap) {
+				level++;
+			}
+			return level;
+		}, mt_sum)};
+
+		DM803::Xoshiro256 rng(42);
+		DM803::GeometricLevels level_distribution(p, level_cap);
+		long sum{};
+		double time{time_draws(draws, [&]() { return level_distribution(rng); }, sum)};
+
+		// Levels i or greater among as many draws as the list has keys, against n * p^(i-1)
+		std::vector<long> at_least(level_cap + 2);
+		for (long i = 0; i < keys; i++) {
+			at_least[level_distribution(rng)]++;
+		}
+		for (int level = level_cap; level > 0; level--) {
+			at_least[level] += at_least[level+1];
+		}
+		int highest{1};
+		while (highest < level_cap && at_least[highest+1] > 0) {
+			highest++;
+		}
+		double L{std::log2(keys) / -std::log2(p)};
+		double worst_error{0.0};
+		// Levels expected to be drawn fewer than 1000 times are left out, as their counts are noise
+		for (int level = 1; keys * std::pow(p, level - 1) >= 1000; level++) {
+			double expected{keys * std::pow(p, level - 1)};
+			worst_error = std::max(worst_error, std::abs(at_least[level] - expected) / expected);
+		}
+		std::cout << std::setprecision(5) << p << "\t" << std::fixed << std::setprecision(2) << mt_time
+		          << "\t\t" << time << "\t\t" << static_cast<double>(mt_sum) / draws << " / "
+		          << static_cast<double>(sum) / draws << "\t\t" << highest << "\t" << L << "\t"
+		          << worst_error * 100 << "%" << std::defaultfloat << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,960 @@
+/**
+ * @file lsm_store.hpp
+ * @brief Header-only log-structured key-value store with Skip List memtables
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * A small log-structured merge store [1] keeping its data in a directory. Writes go to a Skip List,
+ * the memtable, holding for every key either its value or a tombstone if it was deleted. Once the
+ * memtable holds the given number of keys, it is frozen and a new one takes the writes, while a
+ * background thread streams the frozen one in order into an immutable sorted run file. A run is
+ * made of blocks of records sorted by key, followed by the first key of every block and a Bloom
+ * filter over all keys, and only those two are kept in memory, so the store can hold more data
+ * than fits in memory.
+ *
+ * Reads look in the memtable, then in the frozen memtables and the runs from the newest to the
+ * oldest, and the first one holding the key decides. A run is only read from disk if its Bloom
+ * filter says it may hold the key, and then only the one block that may hold it. Range scans
+ * merge all of them, with the newest winning on equal keys. When there are more than the given
+ * number of runs, the background thread merges all of them into one, which also drops the
+ * tombstones, since no older data is left for them to hide.
+ *
+ * The store is used by one thread at a time, in addition to the background thread, which only
+ * ever reads the frozen memtables. There is no write-ahead log, so keys in memtables are lost if
+ * the process stops without destroying the store, and a stop during a compaction may bring back
+ * keys deleted before it. Keys and values are written to the run files byte for byte, so they
+ * must be trivially copyable and default constructible, and keys that compare equal must hash
+ * equally.
+ *
+ * References:
+ * [1] Patrick O'Neil, Edward Cheng, Dieter Gawlick and Elizabeth O'Neil. The Log-Structured
+ *     Merge-Tree (LSM-Tree). Acta Informatica 33(4), 351-385, 1996.
+ */
+#ifndef LSM_STORE_HPP
+#define LSM_STORE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "skip_list.hpp"
+
+namespace DM803
+{
+template<class Key, class Value, class Compare = std::less<Key>, class Hash = std::hash<Key>>
+class LsmStore
+{
+	static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+	              "keys and values are stored in the run files byte for byte and must be trivially copyable");
+
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using key_compare = Compare;
+	using size_type = std::size_t;
+
+	// Default number of keys in a memtable before it is frozen
+	static constexpr size_t MEMTABLE_LIMIT{1 << 16};
+
+	// Default number of runs above which they are merged
+	static constexpr size_t MAX_RUNS{8};
+
+	// Number of frozen memtables waiting to be written before writes wait for the background thread
+	static constexpr size_t MAX_FROZEN{2};
+
+	/**
+	 * @brief Opens the store kept in the given directory, creating the directory if needed
+	 *
+	 * The store must not be used if is_open() returns false afterwards.
+	 *
+	 * @param directory Directory holding the run files
+	 * @param memtable_limit Number of keys in a memtable before it is frozen
+	 * @param max_runs Number of runs above which they are merged
+	 * @param comp Comparator defining the order of the keys, which must be the same every time
+	 *             the store is opened
+	 * @param hash Hash function for the Bloom filters, which must be the same every time the
+	 *             store is opened
+	 */
+	explicit LsmStore(const std::string &directory, const size_t memtable_limit=MEMTABLE_LIMIT,
+	                  const size_t max_runs=MAX_RUNS, const Compare &comp=Compare(), const Hash &hash=Hash())
+		: directory(directory),
+		  memtable_limit(std::max<size_t>(1, memtable_limit)),
+		  max_runs(std::max<size_t>(1, max_runs)),
+		  comp(comp),
+		  hash(hash),
+		  active(new_memtable())
+	{
+		open_runs();
+		flusher = std::thread(&LsmStore::flush_frozen, this);
+	}
+
+	LsmStore(const LsmStore &) = delete;
+	LsmStore &operator=(const LsmStore &) = delete;
+
+	/**
+	 * @brief Writes all memtables to runs and stops the background thread
+	 *
+	 */
+	~LsmStore()
+	{
+		freeze();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		frozen_changed.notify_all();
+		flusher.join();
+	}
+
+	/**
+	 * @brief Tells if the directory could be created and all runs in it could be opened
+	 *
+	 * @return bool True if the store can be used
+	 */
+	bool is_open() const
+	{
+		return opened;
+	}
+
+	/**
+	 * @brief Tells if all runs have been written without errors so far. After an error the
+	 *        memtables that could not be written are kept in memory and no more are written
+	 *
+	 * @return bool True if no error occurred
+	 */
+	bool ok() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return !write_error;
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the store, replacing the value if the key is present
+	 *
+	 * @param key Key to insert
+	 * @param value Value to insert
+	 */
+	void put(const Key &key, const Value &value)
+	{
+		write(key, Entry{value, true});
+	}
+
+	/**
+	 * @brief Removes key and its value from the store, if present
+	 *
+	 * @param key Key to remove
+	 */
+	void remove(const Key &key)
+	{
+		write(key, Entry{Value(), false});
+	}
+
+	/**
+	 * @brief Looks up the value stored for the given key
+	 *
+	 * @param key Key to find
+	 * @param value Receives the value if the key is present
+	 * @return bool True if the key is present
+	 */
+	bool get(const Key &key, Value &value) const
+	{
+		Entry entry;
+		if (const Entry *found = active->get(key)) {
+			entry = *found;
+		} else {
+			Snapshot snapshot(take_snapshot());
+			bool found_elsewhere{false};
+			for (size_t i = 0; i < snapshot.frozen.size() && !found_elsewhere; i++) {
+				if (const Entry *in_frozen = snapshot.frozen[i]->get(key)) {
+					entry = *in_frozen;
+					found_elsewhere = true;
+				}
+			}
+			for (size_t i = 0; i < snapshot.runs.size() && !found_elsewhere; i++) {
+				found_elsewhere = snapshot.runs[i]->get(key, entry);
+			}
+			if (!found_elsewhere) {
+				return false;
+			}
+		}
+		if (entry.present) {
+			value = entry.value;
+		}
+		return entry.present;
+	}
+
+	/**
+	 * @brief Visits the keys in [lo, hi] that are present in the store, in order
+	 *
+	 * @param lo Smallest key to visit
+	 * @param hi Largest key to visit
+	 * @param visit Function called with each key and its value
+	 * @return size_t Number of keys visited
+	 */
+	template<class Visitor>
+	size_t range_scan(const Key &lo, const Key &hi, Visitor visit) const
+	{
+		Snapshot snapshot(take_snapshot());
+		std::vector<Cursor> cursors;
+		cursors.emplace_back(*active, lo);
+		for (const auto &list : snapshot.frozen) {
+			cursors.emplace_back(*list, lo);
+		}
+		for (const auto &run : snapshot.runs) {
+			cursors.emplace_back(*run, lo, comp);
+		}
+		size_t visited{0};
+		merge(cursors, &hi, [&](const Key &key, const Entry &entry) {
+			if (entry.present) {
+				visit(key, entry.value);
+				visited++;
+			}
+		});
+		return visited;
+	}
+
+	/**
+	 * @brief Freezes the memtable and waits until all frozen memtables have been written to runs
+	 *
+	 * @return bool True if no error occurred writing the runs
+	 */
+	bool flush()
+	{
+		freeze();
+		std::unique_lock<std::mutex> lock(mutex);
+		frozen_changed.wait(lock, [this] { return frozen.empty() || write_error; });
+		return !write_error;
+	}
+
+	/**
+	 * @brief Merges all runs into one, dropping the tombstones
+	 *
+	 * @return bool True if the merged run was written, or there was nothing to merge
+	 */
+	bool compact()
+	{
+		std::lock_guard<std::mutex> compaction_lock(compaction_mutex);
+		std::vector<std::shared_ptr<SortedRun>> merging(take_snapshot().runs);
+		if (merging.size() < 2) {
+			return true;
+		}
+		size_t count{0};
+		std::vector<Cursor> cursors;
+		for (const auto &run : merging) {
+			count += run->size();
+			cursors.emplace_back(*run, comp);
+		}
+		// The merged run replaces the newest of the runs it merges, so it keeps its place in the
+		// order of the runs when the store is opened again
+		const std::string &path = merging.front()->file_path();
+		RunWriter writer(path + ".tmp", count, hash);
+		merge(cursors, nullptr, [&writer](const Key &key, const Entry &entry) {
+			if (entry.present) {
+				writer.add(key, entry);
+			}
+		});
+		if (!writer.finish() || !install_run(path)) {
+			std::remove((path + ".tmp").c_str());
+			return false;
+		}
+		std::shared_ptr<SortedRun> merged(SortedRun::open(path, comp, hash));
+		if (merged == nullptr) {
+			return false;
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		// Runs flushed in the meantime are newer and in front of the merged ones
+		runs.resize(runs.size() - merging.size());
+		runs.push_back(merged);
+		for (size_t i = 1; i < merging.size(); i++) {
+			merging[i]->discard();
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Returns the number of runs
+	 *
+	 * @return size_t
+	 */
+	size_t run_count() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return runs.size();
+	}
+
+	/**
+	 * @brief Returns the number of keys and tombstones in the memtables
+	 *
+	 * @return size_t
+	 */
+	size_t memtable_size() const
+	{
+		size_t entries{active->size()};
+		for (const auto &list : take_snapshot().frozen) {
+			entries += list->size();
+		}
+		return entries;
+	}
+
+	key_compare key_comp() const
+	{
+		return comp;
+	}
+
+private:
+	// Value of a key, or a tombstone if present is false
+	struct Entry
+	{
+		Value value;
+		bool present;
+	};
+
+	using Memtable = SkipList<Key, Entry, Compare>;
+
+	// Layout of a record in a run file
+	struct Record
+	{
+		Key key;
+		Entry entry;
+	};
+
+	/**
+	 * Bloom filter with 10 bits per key and 7 hash functions, for a false positive rate of
+	 * about 1%, deriving the hash functions from one hash of the key by double hashing
+	 */
+	class BloomFilter
+	{
+	public:
+		static constexpr size_t BITS_PER_KEY{10};
+		static constexpr size_t HASHES{7};
+
+		BloomFilter() = default;
+
+		explicit BloomFilter(const size_t keys)
+			: bits((std::max<size_t>(keys, 1) * BITS_PER_KEY + 63) / 64)
+		{
+		}
+
+		void add(const size_t key_hash)
+		{
+			for_each_bit(key_hash, [this](const size_t bit) { bits[bit / 64] |= std::uint64_t{1} << (bit % 64); });
+		}
+
+		bool may_contain(const size_t key_hash) const
+		{
+			bool all_set{true};
+			for_each_bit(key_hash, [&](const size_t bit) { all_set = all_set && ((bits[bit / 64] >> (bit % 64)) & 1); });
+			return all_set;
+		}
+
+		std::vector<std::uint64_t> bits;
+
+	private:
+		template<class Function>
+		void for_each_bit(const size_t key_hash, Function f) const
+		{
+			std::uint64_t h1{key_hash};
+			std::uint64_t h2{(h1 * 0x9e3779b97f4a7c15ULL) | 1};
+			for (size_t i = 0; i < HASHES; i++) {
+				f((h1 + i * h2) % (bits.size() * 64));
+			}
+		}
+	};
+
+	static constexpr char MAGIC[8]{'D', 'M', '8', '0', '3', 'L', 'S', 'M'};
+
+	// Records per block, the unit a run is read in
+	static constexpr size_t BLOCK_RECORDS{64};
+
+	// Layout of the start of a run file, which is followed by the blocks of records, the first
+	// key of every block and the Bloom filter
+	struct RunHeader
+	{
+		char magic[8];
+		std::uint32_t key_size;
+		std::uint32_t value_size;
+		std::uint64_t count;
+		std::uint64_t bloom_words;
+	};
+
+	/**
+	 * Writes records, given in order, to a new run file
+	 */
+	class RunWriter
+	{
+	public:
+		/**
+		 * @brief Creates the run file
+		 *
+		 * @param path Path of the file
+		 * @param expected_count Upper bound for the number of records, used to size the Bloom filter
+		 * @param hash Hash function for the Bloom filter
+		 */
+		RunWriter(const std::string &path, const size_t expected_count, const Hash &hash)
+			: fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+			  offset(sizeof(RunHeader)),
+			  bloom(expected_count),
+			  hash(hash)
+		{
+			block.reserve(BLOCK_RECORDS);
+		}
+
+		~RunWriter()
+		{
+			if (fd >= 0) {
+				::close(fd);
+			}
+		}
+
+		void add(const Key &key, const Entry &entry)
+		{
+			if (block.size() == BLOCK_RECORDS) {
+				write_block();
+			}
+			Record record;
+			std::memset(static_cast<void *>(&record), 0, sizeof(Record));
+			record.key = key;
+			record.entry = entry;
+			if (block.empty()) {
+				first_keys.push_back(key);
+			}
+			block.push_back(record);
+			bloom.add(hash(key));
+			count++;
+		}
+
+		/**
+		 * @brief Writes the rest of the run and the header, and flushes the file to disk
+		 *
+		 * @return bool True if all writes succeeded
+		 */
+		bool finish()
+		{
+			write_block();
+			write_at(first_keys.data(), first_keys.size() * sizeof(Key));
+			write_at(bloom.bits.data(), bloom.bits.size() * sizeof(std::uint64_t));
+			RunHeader header;
+			std::memset(&header, 0, sizeof(RunHeader));
+			std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+			header.key_size = sizeof(Key);
+			header.value_size = sizeof(Value);
+			header.count = count;
+			header.bloom_words = bloom.bits.size();
+			offset = 0;
+			write_at(&header, sizeof(RunHeader));
+			return failed == false && fd >= 0 && fsync(fd) == 0;
+		}
+
+	private:
+		void write_block()
+		{
+			write_at(block.data(), block.size() * sizeof(Record));
+			block.clear();
+		}
+
+		void write_at(const void *bytes, const size_t n)
+		{
+			if (fd < 0 || pwrite(fd, bytes, n, offset) != static_cast<ssize_t>(n)) {
+				failed = true;
+			}
+			offset += n;
+		}
+
+		int fd;
+		size_t offset;
+		size_t count{0};
+		bool failed{false};
+		std::vector<Record> block;
+		std::vector<Key> first_keys;
+		BloomFilter bloom;
+		const Hash &hash;
+	};
+
+	/**
+	 * An immutable run file, of which the first key of every block and the Bloom filter are kept
+	 * in memory
+	 */
+	class SortedRun
+	{
+	public:
+		/**
+		 * @brief Opens a run file
+		 *
+		 * @param path Path of the file
+		 * @param comp Comparator of the store
+		 * @param hash Hash function of the store
+		 * @return std::shared_ptr<SortedRun> The run, or null if the file cannot be read or is
+		 *                                    not a run of keys and values of the right sizes
+		 */
+		static std::shared_ptr<SortedRun> open(const std::string &path, const Compare &comp, const Hash &hash)
+		{
+			std::shared_ptr<SortedRun> run(new SortedRun(path, comp, hash));
+			RunHeader header;
+			if (run->fd < 0 || !run->read_at(&header, sizeof(RunHeader), 0)
+			    || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+			    || header.key_size != sizeof(Key) || header.value_size != sizeof(Value)) {
+				return nullptr;
+			}
+			run->count = header.count;
+			run->first_keys.resize((header.count + BLOCK_RECORDS - 1) / BLOCK_RECORDS);
+			run->bloom.bits.resize(header.bloom_words);
+			size_t offset{sizeof(RunHeader) + header.count * sizeof(Record)};
+			if (!run->read_at(run->first_keys.data(), run->first_keys.size() * sizeof(Key), offset)
+			    || !run->read_at(run->bloom.bits.data(), header.bloom_words * sizeof(std::uint64_t),
+			                     offset + run->first_keys.size() * sizeof(Key))
+			    || header.bloom_words == 0) {
+				return nullptr;
+			}
+			return run;
+		}
+
+		SortedRun(const SortedRun &) = delete;
+		SortedRun &operator=(const SortedRun &) = delete;
+
+		/**
+		 * @brief Closes the file, and deletes it if the run was discarded
+		 *
+		 */
+		~SortedRun()
+		{
+			if (fd >= 0) {
+				::close(fd);
+			}
+			if (discarded) {
+				std::remove(path.c_str());
+			}
+		}
+
+		/**
+		 * @brief Looks up the record of the given key
+		 *
+		 * @param key Key to find
+		 * @param entry Receives the value or tombstone of the key if found
+		 * @return bool True if the run holds a record for the key
+		 */
+		bool get(const Key &key, Entry &entry) const
+		{
+			if (!bloom.may_contain(hash(key))) {
+				return false;
+			}
+			size_t block{block_of(key)};
+			if (block == first_keys.size()) {
+				return false;
+			}
+			std::vector<Record> records;
+			read_block(block, records);
+			auto found = std::lower_bound(records.begin(), records.end(), key,
+			                              [this](const Record &record, const Key &k) { return comp(record.key, k); });
+			if (found == records.end() || comp(key, found->key)) {
+				return false;
+			}
+			entry = found->entry;
+			return true;
+		}
+
+		/**
+		 * @brief Finds the block that holds the given key if the run holds it
+		 *
+		 * @param key Key to find
+		 * @return size_t The block, or the number of blocks if the key is before the first one
+		 */
+		size_t block_of(const Key &key) const
+		{
+			size_t after = std::upper_bound(first_keys.begin(), first_keys.end(), key, comp) - first_keys.begin();
+			return after == 0 ? first_keys.size() : after - 1;
+		}
+
+		/**
+		 * @brief Reads a block of records from the file
+		 *
+		 * @param block Number of the block
+		 * @param records Receives the records, or none if the read failed
+		 */
+		void read_block(const size_t block, std::vector<Record> &records) const
+		{
+			size_t first{block * BLOCK_RECORDS};
+			records.resize(std::min(BLOCK_RECORDS, count - first));
+			if (!read_at(records.data(), records.size() * sizeof(Record), sizeof(RunHeader) + first * sizeof(Record))) {
+				records.clear();
+			}
+		}
+
+		/**
+		 * @brief Marks the run to have its file deleted once it is no longer used
+		 *
+		 */
+		void discard()
+		{
+			discarded = true;
+		}
+
+		size_t size() const
+		{
+			return count;
+		}
+
+		size_t blocks() const
+		{
+			return first_keys.size();
+		}
+
+		const std::string &file_path() const
+		{
+			return path;
+		}
+
+	private:
+		SortedRun(const std::string &path, const Compare &comp, const Hash &hash)
+			: path(path),
+			  fd(::open(path.c_str(), O_RDONLY)),
+			  comp(comp),
+			  hash(hash)
+		{
+		}
+
+		bool read_at(void *bytes, const size_t n, const size_t offset) const
+		{
+			return pread(fd, bytes, n, offset) == static_cast<ssize_t>(n);
+		}
+
+		std::string path;
+		int fd;
+		size_t count{0};
+		std::vector<Key> first_keys;
+		BloomFilter bloom;
+		bool discarded{false};
+		Compare comp;
+		Hash hash;
+	};
+
+	/**
+	 * Position in the records of a memtable or a run, in order of their keys
+	 */
+	class Cursor
+	{
+	public:
+		/**
+		 * @brief Starts at the first key >= lo of a memtable
+		 *
+		 */
+		Cursor(const Memtable &list, const Key &lo)
+			: list(&list),
+			  it(list.lower_bound(lo))
+		{
+		}
+
+		/**
+		 * @brief Starts at the first key >= lo of a run
+		 *
+		 */
+		Cursor(const SortedRun &run, const Key &lo, const Compare &comp)
+			: run(&run)
+		{
+			block = run.block_of(lo);
+			if (block == run.blocks()) {
+				block = 0;
+			}
+			load();
+			while (valid() && comp(key(), lo)) {
+				next();
+			}
+		}
+
+		/**
+		 * @brief Starts at the first key of a run
+		 *
+		 */
+		Cursor(const SortedRun &run, const Compare &)
+			: run(&run)
+		{
+			load();
+		}
+
+		bool valid() const
+		{
+			return list != nullptr ? it != list->end() : position < records.size();
+		}
+
+		const Key &key() const
+		{
+			return list != nullptr ? it->first : records[position].key;
+		}
+
+		const Entry &entry() const
+		{
+			return list != nullptr ? it->second : records[position].entry;
+		}
+
+		void next()
+		{
+			if (list != nullptr) {
+				++it;
+			} else if (++position == records.size() && ++block < run->blocks()) {
+				load();
+			}
+		}
+
+	private:
+		void load()
+		{
+			position = 0;
+			records.clear();
+			if (block < run->blocks()) {
+				run->read_block(block, records);
+			}
+		}
+
+		const Memtable *list{nullptr};
+		typename Memtable::const_iterator it{};
+		const SortedRun *run{nullptr};
+		size_t block{0};
+		size_t position{0};
+		std::vector<Record> records;
+	};
+
+	// Frozen memtables and runs, each from the newest to the oldest
+	struct Snapshot
+	{
+		std::vector<std::shared_ptr<const Memtable>> frozen;
+		std::vector<std::shared_ptr<SortedRun>> runs;
+	};
+
+	/**
+	 * @brief Merges the cursors, given from the newest to the oldest, and visits every key once
+	 *        with its record from the newest cursor holding it
+	 *
+	 * @param cursors Cursors to merge
+	 * @param hi Largest key to visit, or null to visit all keys
+	 * @param visit Function called with each key and its value or tombstone
+	 */
+	template<class Visitor>
+	void merge(std::vector<Cursor> &cursors, const Key *hi, Visitor visit) const
+	{
+		for (;;) {
+			Cursor *smallest = nullptr;
+			for (Cursor &cursor : cursors) {
+				if (cursor.valid() && (smallest == nullptr || comp(cursor.key(), smallest->key()))) {
+					smallest = &cursor;
+				}
+			}
+			if (smallest == nullptr || (hi != nullptr && comp(*hi, smallest->key()))) {
+				return;
+			}
+			Key key(smallest->key());
+			visit(key, smallest->entry());
+			for (Cursor &cursor : cursors) {
+				if (cursor.valid() && !comp(key, cursor.key())) {
+					cursor.next();
+				}
+			}
+		}
+	}
+
+	Memtable *new_memtable() const
+	{
+		return new Memtable(0.5, Memtable::LEVEL_CAP, comp);
+	}
+
+	void write(const Key &key, const Entry &entry)
+	{
+		if (Entry *found = active->get(key)) {
+			*found = entry;
+		} else {
+			active->insert(key, entry);
+		}
+		if (active->size() >= memtable_limit) {
+			freeze();
+			std::unique_lock<std::mutex> lock(mutex);
+			frozen_changed.wait(lock, [this] { return frozen.size() <= MAX_FROZEN || write_error; });
+		}
+	}
+
+	/**
+	 * @brief Hands the memtable to the background thread and starts a new one, if it is not empty
+	 *
+	 */
+	void freeze()
+	{
+		if (active->empty()) {
+			return;
+		}
+		std::shared_ptr<const Memtable> list(active.release());
+		active.reset(new_memtable());
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			frozen.insert(frozen.begin(), list);
+		}
+		frozen_changed.notify_all();
+	}
+
+	Snapshot take_snapshot() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return Snapshot{frozen, runs};
+	}
+
+	std::string run_path(const unsigned long long sequence) const
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "run-%08llu.sst", sequence);
+		return (std::filesystem::path(directory) / name).string();
+	}
+
+	/**
+	 * @brief Gives a run written to its path with ".tmp" appended its own path, and flushes the
+	 *        directory, so that the run is either complete under its own name or a temporary
+	 *        file removed when the store is opened again
+	 *
+	 * @param path Path of the run
+	 * @return bool True if the run was renamed and the directory flushed
+	 */
+	bool install_run(const std::string &path) const
+	{
+		if (std::rename((path + ".tmp").c_str(), path.c_str()) != 0) {
+			return false;
+		}
+		int fd{::open(directory.c_str(), O_RDONLY | O_DIRECTORY)};
+		bool synced{fd >= 0 && fsync(fd) == 0};
+		if (fd >= 0) {
+			::close(fd);
+		}
+		return synced;
+	}
+
+	/**
+	 * @brief Creates the directory if needed, removes files left behind by an unfinished write
+	 *        and opens the runs in it
+	 *
+	 */
+	void open_runs()
+	{
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		std::vector<unsigned long long> sequences;
+		for (const auto &file : std::filesystem::directory_iterator(directory, error)) {
+			std::string name(file.path().filename().string());
+			unsigned long long sequence{};
+			char suffix[8]{};
+			if (std::sscanf(name.c_str(), "run-%llu.%7s", &sequence, suffix) != 2) {
+				continue;
+			}
+			if (std::strcmp(suffix, "sst") == 0) {
+				sequences.push_back(sequence);
+			} else if (std::strcmp(suffix, "sst.tmp") == 0) {
+				std::filesystem::remove(file.path(), error);
+			}
+		}
+		if (error) {
+			return;
+		}
+		std::sort(sequences.rbegin(), sequences.rend());
+		for (unsigned long long sequence : sequences) {
+			std::shared_ptr<SortedRun> run(SortedRun::open(run_path(sequence), comp, hash));
+			if (run == nullptr) {
+				return;
+			}
+			runs.push_back(run);
+		}
+		next_sequence = sequences.empty() ? 0 : sequences.front() + 1;
+		opened = true;
+	}
+
+	/**
+	 * @brief Body of the background thread, writing the oldest frozen memtable to a run until
+	 *        there are none left and the store is being destroyed, and merging the runs when
+	 *        there are too many
+	 *
+	 */
+	void flush_frozen()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			frozen_changed.wait(lock, [this] { return stopping || (!frozen.empty() && !write_error); });
+			if (frozen.empty() || write_error) {
+				return;
+			}
+			std::shared_ptr<const Memtable> list(frozen.back());
+			std::string path(run_path(next_sequence++));
+			lock.unlock();
+
+			// Written under a temporary name first, like a compaction, so a stop part way leaves
+			// no run with a partly written header behind
+			RunWriter writer(path + ".tmp", list->size(), hash);
+			for (const auto &element : *list) {
+				writer.add(element.first, element.second);
+			}
+			std::shared_ptr<SortedRun> run;
+			if (writer.finish() && install_run(path)) {
+				run = SortedRun::open(path, comp, hash);
+			} else {
+				std::remove((path + ".tmp").c_str());
+			}
+
+			lock.lock();
+			if (run == nullptr) {
+				write_error = true;
+				frozen_changed.notify_all();
+				return;
+			}
+			// The frozen memtable and its run hold the same keys, so readers may see either
+			runs.insert(runs.begin(), run);
+			frozen.pop_back();
+			frozen_changed.notify_all();
+			if (runs.size() > max_runs) {
+				lock.unlock();
+				bool compacted{compact()};
+				lock.lock();
+				if (!compacted) {
+					write_error = true;
+					frozen_changed.notify_all();
+					return;
+				}
+			}
+		}
+	}
+
+	std::string directory;
+	size_t memtable_limit;
+	size_t max_runs;
+	Compare comp;
+	Hash hash;
+
+	// Memtable taking the writes, only used by the thread using the store
+	std::unique_ptr<Memtable> active;
+
+	// Guards everything below, which is shared with the background thread
+	mutable std::mutex mutex;
+	std::condition_variable frozen_changed;
+	std::vector<std::shared_ptr<const Memtable>> frozen;
+	std::vector<std::shared_ptr<SortedRun>> runs;
+	unsigned long long next_sequence{0};
+	bool opened{false};
+	bool stopping{false};
+	bool write_error{false};
+
+	// Only one merge of the runs at a time
+	std::mutex compaction_mutex;
+
+	std::thread flusher;
+};
+} // namespace DM803
+
+#endif // LSM_STORE_HPP
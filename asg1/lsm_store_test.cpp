@@ -0,0 +1,199 @@
+/**
+ * @file lsm_store_test.cpp
+ * @brief Randomised test for the log-structured store built on Skip List memtables
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Makes random puts, removes, lookups and range scans against an LSM Store with small memtables,
+ * so that memtables are frozen, written to runs and merged throughout, and checks every result
+ * against a std::map. Finally closes and reopens the store and checks that its contents survived,
+ * also with a partly written run left behind as by a stop during a flush, and checks that writes
+ * and flush() return with an error when the background thread cannot merge the runs.
+ */
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+
+#include <sys/resource.h>
+
+#include "lsm_store.hpp"
+
+using Store = DM803::LsmStore<int, long>;
+
+/**
+ * @brief Prints a helper message to stdout for how to use this program
+ *
+ * @param program First argument from the command line, i.e. argv[0]
+ */
+static void show_usage(const std::string& program)
+{
+	std::cout << "Usage: " << program << " <directory> [<operations>]\n"
+	          << "Arguments:\n"
+	          << "\tdirectory\tDirectory to keep the store in, which is emptied first.\n"
+	          << "\toperations\tOptional: Number of operations. Default value is 100000.\n"
+	          << std::endl;
+}
+
+/**
+ * @brief Checks that the store holds exactly the keys and values of the reference map
+ *
+ * @param store Store to check
+ * @param reference Expected contents
+ * @param phase Name of the phase, used in error messages
+ * @return bool True if the store passed the check
+ */
+static bool check_store(const Store &store, const std::map<int, long> &reference, const std::string &phase)
+{
+	auto expected = reference.begin();
+	bool matches{true};
+	size_t visited{store.range_scan(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+	                                [&](const int key, const long value) {
+		matches = matches && expected != reference.end() && expected->first == key && expected->second == value;
+		if (expected != reference.end()) {
+			++expected;
+		}
+	})};
+	for (const auto &element : reference) {
+		long value{};
+		matches = matches && store.get(element.first, value) && value == element.second;
+	}
+	if (!matches || visited != reference.size()) {
+		std::cout << "F - " << phase << ": expected " << reference.size() << " keys, visited " << visited
+		          << (matches ? "" : ", contents differ") << std::endl;
+		return false;
+	}
+	std::cout << "S - " << phase << ": " << visited << " keys" << std::endl;
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	int operations{100000};
+	try {
+		if (argc > 2) {
+			operations = std::stoi(argv[2]);
+		}
+	} catch (std::exception &e) {
+		operations = 0;
+	}
+	if (argc < 2 || argc > 3 || operations < 1) {
+		show_usage(argv[0]);
+		return 1;
+	}
+	std::error_code error;
+	std::filesystem::remove_all(argv[1], error);
+
+	std::map<int, long> reference;
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<> key_distribution(0, operations / 2);
+	bool passed{true};
+	{
+		Store store(argv[1], 1000, 4);
+		if (!store.is_open()) {
+			std::cout << "F - cannot open store in '" << argv[1] << "'" << std::endl;
+			return 1;
+		}
+		for (int i = 0; i < operations && passed; i++) {
+			int key{key_distribution(rng)};
+			int operation{static_cast<int>(rng() % 10)};
+			if (operation < 5) {
+				store.put(key, i);
+				reference[key] = i;
+			} else if (operation < 7) {
+				store.remove(key);
+				reference.erase(key);
+			} else if (operation < 9) {
+				long value{};
+				auto expected = reference.find(key);
+				bool found{store.get(key, value)};
+				if (found != (expected != reference.end()) || (found && value != expected->second)) {
+					std::cout << "F - lookup of '" << key << "' after " << i << " operations" << std::endl;
+					passed = false;
+				}
+			} else {
+				size_t visited{store.range_scan(key, key + 99, [](const int, const long) {})};
+				size_t expected{static_cast<size_t>(std::distance(reference.lower_bound(key), reference.upper_bound(key + 99)))};
+				if (visited != expected) {
+					std::cout << "F - range scan from '" << key << "' after " << i << " operations" << std::endl;
+					passed = false;
+				}
+			}
+		}
+		passed = passed && check_store(store, reference, "random operations");
+		passed = passed && store.flush() && check_store(store, reference, "flush");
+		passed = passed && store.compact() && store.run_count() <= 1 && check_store(store, reference, "compaction");
+		for (int i = 0; i < 2000; i++) {
+			int key{key_distribution(rng)};
+			store.remove(key);
+			reference.erase(key);
+		}
+		passed = passed && store.ok();
+	}
+	{
+		Store reopened(argv[1], 1000, 4);
+		passed = passed && reopened.is_open() && check_store(reopened, reference, "reopen");
+	}
+
+	// A stop during a flush leaves the first part of the next run under its temporary name
+	std::filesystem::path newest;
+	for (const auto &file : std::filesystem::directory_iterator(argv[1], error)) {
+		newest = std::max(newest, file.path());
+	}
+	std::string name(newest.filename().string());
+	unsigned long long sequence{};
+	if (std::sscanf(name.c_str(), "run-%llu.sst", &sequence) != 1) {
+		std::cout << "F - no run left in '" << argv[1] << "'" << std::endl;
+		return 1;
+	}
+	char partial_name[32];
+	std::snprintf(partial_name, sizeof(partial_name), "run-%08llu.sst.tmp", sequence + 1);
+	std::filesystem::path partial(std::filesystem::path(argv[1]) / partial_name);
+	{
+		std::ifstream in(newest, std::ios::binary);
+		std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		std::ofstream out(partial, std::ios::binary);
+		out.write(bytes.data(), bytes.size() / 2);
+	}
+	{
+		Store recovered(argv[1], 1000, 4);
+		if (!recovered.is_open() || std::filesystem::exists(partial)) {
+			std::cout << "F - partly written run: store " << (recovered.is_open() ? "opened" : "not opened")
+			          << ", temporary file " << (std::filesystem::exists(partial) ? "kept" : "removed") << std::endl;
+			return 1;
+		}
+		passed = check_store(recovered, reference, "partly written run") && passed;
+	}
+
+	// Limits files to half the size of the run on disk, so the small runs of single keys can be
+	// written but merging them into it fails, while writes wait for the background thread
+	rlimit old_limit{};
+	getrlimit(RLIMIT_FSIZE, &old_limit);
+	rlimit limit(old_limit);
+	limit.rlim_cur = std::filesystem::file_size(newest, error) / 2;
+	std::signal(SIGXFSZ, SIG_IGN);
+	setrlimit(RLIMIT_FSIZE, &limit);
+	{
+		Store failing(argv[1], 1, 1);
+		for (int i = 0; i < 100; i++) {
+			failing.put(i, i);
+		}
+		if (failing.flush() || failing.ok()) {
+			std::cout << "F - failed compaction: no error reported" << std::endl;
+			passed = false;
+		} else {
+			std::cout << "S - failed compaction: writes and flush() returned with an error" << std::endl;
+		}
+	}
+	setrlimit(RLIMIT_FSIZE, &old_limit);
+	return passed ? 0 : 1;
+}
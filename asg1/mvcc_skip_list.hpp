@@ -0,0 +1,571 @@
+/**
+ * @file mvcc_skip_list.hpp
+ * @brief Multi-version Skip List with snapshot reads on top of the Concurrent Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Ordered map keeping older versions of its values for readers that need a consistent view of it
+ * while writers go on changing it. Every key maps to a chain of versions, newest first, in a
+ * Concurrent Skip List. A write adds a version stamped with the next value of a global commit
+ * counter, which is only advanced once the version is linked, and a delete adds a version without
+ * a value. A snapshot remembers the commit counter when it was taken, and its searches and scans
+ * read, for every key, the newest version stamped no later than that, so they never wait for
+ * writers and never see part of a write made after the snapshot.
+ *
+ * Writers take turns, so that versions are linked in the order of their stamps, while readers
+ * never take a lock besides registering and releasing a snapshot. A version is only needed while
+ * it is the newest one as of some snapshot, so every write cuts the versions of its key older than
+ * the one the oldest snapshot reads, and a sweep over all keys does the same once the versions left
+ * behind by released snapshots add up. Keys whose only version left is a delete are unlinked. Cut
+ * versions are handed to an epoch manager, so a reader still walking over them is not disturbed.
+ *
+ * References:
+ * [1] Philip A. Bernstein and Nathan Goodman. Multiversion concurrency control - theory and
+ *     algorithms. ACM Transactions on Database Systems 8(4):465-483, 1983.
+ */
+#ifndef MVCC_SKIP_LIST_HPP
+#define MVCC_SKIP_LIST_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <utility>
+
+#include "concurrent_skip_list.hpp"
+#include "epoch_reclamation.hpp"
+
+namespace DM803
+{
+template<class Key, class Value, class Compare = std::less<Key>>
+class MvccSkipList
+{
+	struct Version
+	{
+		// Commit stamp of the write that made the version
+		const std::uint64_t stamp;
+
+		// Value written, or empty if the write deleted the key
+		const std::optional<Value> value;
+
+		// Next older version, cut off once no snapshot reads it
+		std::atomic<Version *> older;
+	};
+
+	struct Chain
+	{
+		std::atomic<Version *> newest;
+	};
+
+	using List = ConcurrentSkipList<Key, Chain *, Compare>;
+
+public:
+	// Least number of versions left behind by snapshots before all keys are swept
+	static constexpr size_t COLLECT_MIN{1024};
+
+	/**
+	 * Point-in-time view of the list, which sees every write committed before it was taken and no
+	 * write committed after. Keeps the versions it reads from being collected until destroyed,
+	 * which must happen before the list is destroyed.
+	 */
+	class Snapshot
+	{
+	public:
+		Snapshot(const Snapshot &) = delete;
+		Snapshot &operator=(const Snapshot &) = delete;
+
+		Snapshot(Snapshot &&other)
+			: owner(other.owner),
+			  stamp(other.stamp)
+		{
+			other.owner = nullptr;
+		}
+
+		~Snapshot()
+		{
+			if (owner != nullptr) {
+				owner->release(stamp);
+			}
+		}
+
+		/**
+		 * @brief Searches the snapshot for the given key
+		 *
+		 * @param search_key Key to find
+		 * @param value If not null and the key is found, receives a copy of the value
+		 * @return bool True if the key was present when the snapshot was taken
+		 */
+		bool search(const Key &search_key, Value *value=nullptr) const
+		{
+			EpochManager::Guard guard(owner->epochs);
+
+			Chain *chain{nullptr};
+			return owner->list.search(search_key, &chain) && copy_out(visible(chain, stamp), value);
+		}
+
+		/**
+		 * @brief Visits the key-value pairs of the snapshot with keys in [lo, hi] in ascending
+		 *        key order
+		 *
+		 * @param lo Smallest key to visit
+		 * @param hi Largest key to visit
+		 * @param visit Callback invoked as visit(key, value)
+		 * @return size_t Number of pairs visited
+		 */
+		template<class Visitor>
+		size_t range_scan(const Key &lo, const Key &hi, Visitor visit) const
+		{
+			EpochManager::Guard guard(owner->epochs);
+
+			size_t visited{0};
+			owner->list.range_scan(lo, hi, [&](const Key &key, Chain *chain) {
+				const Version *version = visible(chain, stamp);
+				if (version != nullptr && version->value) {
+					visit(key, *version->value);
+					visited++;
+				}
+			});
+			return visited;
+		}
+
+		/**
+		 * @brief Visits every key-value pair of the snapshot in ascending key order
+		 *
+		 * @param visit Callback invoked as visit(key, value)
+		 */
+		template<class Visitor>
+		void for_each(Visitor visit) const
+		{
+			EpochManager::Guard guard(owner->epochs);
+
+			owner->list.for_each([&](const Key &key, Chain *chain) {
+				const Version *version = visible(chain, stamp);
+				if (version != nullptr && version->value) {
+					visit(key, *version->value);
+				}
+			});
+		}
+
+		/**
+		 * @brief Returns the commit stamp the snapshot reads at
+		 *
+		 * @return std::uint64_t Stamp of the last write the snapshot sees
+		 */
+		std::uint64_t version() const
+		{
+			return stamp;
+		}
+
+	private:
+		friend class MvccSkipList;
+
+		Snapshot(MvccSkipList &owner, const std::uint64_t stamp)
+			: owner(&owner),
+			  stamp(stamp)
+		{
+		}
+
+		MvccSkipList *owner;
+		std::uint64_t stamp;
+	};
+
+	/**
+	 * @brief Constructs a new Mvcc Skip List object
+	 *
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater
+	 * @param level_cap Upper bound for the number of possible forward pointers
+	 * @param comp Comparator defining the order of the keys
+	 */
+	explicit MvccSkipList(const double p=0.5, const int level_cap=32, const Compare &comp=Compare())
+		: list(p, level_cap, comp)
+	{
+	}
+
+	MvccSkipList(const MvccSkipList &) = delete;
+	MvccSkipList &operator=(const MvccSkipList &) = delete;
+
+	/**
+	 * @brief Destroys the Mvcc Skip List object
+	 *
+	 * No other thread may access the list, and no snapshot of it may be left, when it is
+	 * destroyed.
+	 */
+	~MvccSkipList()
+	{
+		list.for_each([](const Key &, Chain *chain) { reclaim_chain(chain); });
+	}
+
+	/**
+	 * @brief Takes a snapshot of the writes committed so far
+	 *
+	 * @return Snapshot Handle reading the list as it is now
+	 */
+	Snapshot snapshot()
+	{
+		std::lock_guard<std::mutex> lock(snapshot_mutex);
+		const std::uint64_t stamp{committed.load()};
+		snapshots.insert(stamp);
+		return Snapshot(*this, stamp);
+	}
+
+	/**
+	 * @brief Searches the latest committed version of the list for the given key
+	 *
+	 * @param search_key Key to find
+	 * @param value If not null and the key is found, receives a copy of the value
+	 * @return bool True if the key was found, false otherwise
+	 */
+	bool search(const Key &search_key, Value *value=nullptr)
+	{
+		EpochManager::Guard guard(epochs);
+
+		while (true) {
+			const std::uint64_t stamp{committed.load()};
+			Chain *chain{nullptr};
+			if (!list.search(search_key, &chain)) {
+				return false;
+			}
+			// Without a snapshot, the versions this search reads may be cut by a later write, in
+			// which case it starts over from that write
+			const Version *version = visible(chain, stamp);
+			if (version != nullptr || stamp == committed.load()) {
+				return copy_out(version, value);
+			}
+		}
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Mvcc Skip List
+	 *
+	 * @param search_key Key to insert
+	 * @param new_value Value to insert
+	 * @return bool True if key and value was inserted, false otherwise (e.g. key already present)
+	 */
+	bool insert(const Key &search_key, const Value &new_value)
+	{
+		std::lock_guard<std::mutex> lock(write_mutex);
+		EpochManager::Guard guard(epochs);
+
+		Chain *chain = find_chain(search_key);
+		if (chain != nullptr && chain->newest.load()->value) {
+			return false;
+		}
+		write(search_key, chain, new_value);
+		return true;
+	}
+
+	/**
+	 * @brief Inserts the key with the given value, or gives the key the value if present
+	 *
+	 * @param search_key Key to insert or update
+	 * @param new_value Value to store
+	 * @return bool True if the key was inserted, false if it was updated
+	 */
+	bool insert_or_assign(const Key &search_key, const Value &new_value)
+	{
+		std::lock_guard<std::mutex> lock(write_mutex);
+		EpochManager::Guard guard(epochs);
+
+		Chain *chain = find_chain(search_key);
+		const bool inserted{chain == nullptr || !chain->newest.load()->value};
+		write(search_key, chain, new_value);
+		return inserted;
+	}
+
+	/**
+	 * @brief Deletes the key, if present, from the latest version of the Mvcc Skip List.
+	 *        Snapshots taken before still see it
+	 *
+	 * @param search_key Key to be deleted
+	 * @return bool True if key was found and deleted, false otherwise
+	 */
+	bool remove(const Key &search_key)
+	{
+		std::lock_guard<std::mutex> lock(write_mutex);
+		EpochManager::Guard guard(epochs);
+
+		Chain *chain = find_chain(search_key);
+		if (chain == nullptr || !chain->newest.load()->value) {
+			return false;
+		}
+		write(search_key, chain, std::nullopt);
+		return true;
+	}
+
+	/**
+	 * @brief Cuts the versions of every key that no snapshot reads any longer, without waiting
+	 *        for the versions left behind to add up
+	 *
+	 */
+	void collect()
+	{
+		std::lock_guard<std::mutex> lock(write_mutex);
+		EpochManager::Guard guard(epochs);
+
+		collect_all();
+	}
+
+	/**
+	 * @brief Returns the number of keys in the latest version of the Mvcc Skip List
+	 *
+	 * @return size_t
+	 */
+	size_t size() const
+	{
+		return live_keys.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Returns the number of versions kept for the keys and snapshots, which falls back
+	 *        to size() once no snapshot is left and the list has been collected
+	 *
+	 * @return size_t
+	 */
+	size_t versions() const
+	{
+		return version_count.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Returns the commit stamp of the last write
+	 *
+	 * @return std::uint64_t
+	 */
+	std::uint64_t version() const
+	{
+		return committed.load();
+	}
+
+private:
+	/**
+	 * @brief Finds the newest version of a chain stamped no later than the given stamp
+	 *
+	 * @param chain Chain to search
+	 * @param stamp Commit stamp to read at
+	 * @return const Version* The version, or null if the key did not exist at that stamp
+	 */
+	static const Version *visible(const Chain *chain, const std::uint64_t stamp)
+	{
+		const Version *version = chain->newest.load(std::memory_order_acquire);
+		while (version != nullptr && version->stamp > stamp) {
+			version = version->older.load(std::memory_order_acquire);
+		}
+		return version;
+	}
+
+	/**
+	 * @brief Copies the value of a version to where the caller asked for it
+	 *
+	 * @param version Version to copy from, or null
+	 * @param value If not null, receives a copy of the value
+	 * @return bool True if the version holds a value
+	 */
+	static bool copy_out(const Version *version, Value *value)
+	{
+		if (version == nullptr || !version->value) {
+			return false;
+		}
+		if (value != nullptr) {
+			*value = *version->value;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Finds the chain of a key. Must be called by the writer
+	 *
+	 * @param search_key Key to find
+	 * @return Chain* The chain, or null if the key has none
+	 */
+	Chain *find_chain(const Key &search_key)
+	{
+		Chain *chain{nullptr};
+		list.search(search_key, &chain);
+		return chain;
+	}
+
+	/**
+	 * @brief Adds a version to the chain of a key and commits it, then cuts the versions of the
+	 *        key no snapshot reads any longer. Must be called by the writer, pinned
+	 *
+	 * @param search_key Key written
+	 * @param chain Chain of the key, or null to start one
+	 * @param new_value Value written, or empty to delete the key
+	 */
+	void write(const Key &search_key, Chain *chain, std::optional<Value> new_value)
+	{
+		const std::uint64_t stamp{committed.load() + 1};
+		const bool had_value{chain != nullptr && chain->newest.load()->value};
+		const bool has_value{new_value.has_value()};
+		Version *version = new Version{stamp, std::move(new_value), {chain != nullptr ? chain->newest.load() : nullptr}};
+		if (chain == nullptr) {
+			try {
+				chain = new Chain{{version}};
+				list.insert(search_key, chain);
+			} catch (...) {
+				delete chain;
+				delete version;
+				throw;
+			}
+		} else {
+			chain->newest.store(version, std::memory_order_release);
+		}
+		version_count.fetch_add(1, std::memory_order_relaxed);
+		if (has_value && !had_value) {
+			live_keys.fetch_add(1, std::memory_order_relaxed);
+		} else if (had_value && !has_value) {
+			live_keys.fetch_sub(1, std::memory_order_relaxed);
+		}
+		committed.store(stamp);
+
+		prune(search_key, chain, oldest());
+		const size_t left_behind{version_count.load(std::memory_order_relaxed) - list.size()};
+		if (left_behind >= collect_threshold) {
+			collect_all();
+		}
+	}
+
+	/**
+	 * @brief Cuts the versions of a key older than the one read at the given stamp, and the
+	 *        delete at the end of the chain, if any. Unlinks the key if all that is left is a
+	 *        delete. Must be called by the writer, pinned
+	 *
+	 * @param search_key Key of the chain
+	 * @param chain Chain to cut
+	 * @param oldest Commit stamp of the oldest snapshot, or of the last write if there is none
+	 */
+	void prune(const Key &search_key, Chain *chain, const std::uint64_t oldest)
+	{
+		Version *newer{nullptr};
+		Version *keep = chain->newest.load();
+		while (keep != nullptr && keep->stamp > oldest) {
+			newer = keep;
+			keep = keep->older.load();
+		}
+		if (keep == nullptr) {
+			return;
+		}
+		retire_versions(keep->older.exchange(nullptr));
+		if (keep->value) {
+			return;
+		}
+		// Every reader finds the key deleted, whether it reads the delete or nothing at all
+		if (newer != nullptr) {
+			newer->older.store(nullptr);
+			retire_versions(keep);
+		} else {
+			list.remove(search_key);
+			version_count.fetch_sub(1, std::memory_order_relaxed);
+			epochs.retire(chain, &reclaim_chain);
+		}
+	}
+
+	/**
+	 * @brief Cuts the versions of every key no snapshot reads any longer, and sets how many
+	 *        versions may be left behind before the next sweep, so that the sweeps take
+	 *        amortized O(1) time per write. Must be called by the writer, pinned
+	 *
+	 */
+	void collect_all()
+	{
+		const std::uint64_t oldest_stamp{oldest()};
+		// Removing the key being visited is safe, as the traversal is pinned in the list
+		list.for_each([&](const Key &key, Chain *chain) { prune(key, chain, oldest_stamp); });
+		const size_t left_behind{version_count.load(std::memory_order_relaxed) - list.size()};
+		collect_threshold = std::max(std::max(COLLECT_MIN, list.size()), 2 * left_behind);
+	}
+
+	/**
+	 * @brief Retires a version cut off from its chain and all versions older than it
+	 *
+	 * @param version Version to retire, or null
+	 */
+	void retire_versions(Version *version)
+	{
+		while (version != nullptr) {
+			Version *older = version->older.load();
+			epochs.retire(version, &reclaim_version);
+			version_count.fetch_sub(1, std::memory_order_relaxed);
+			version = older;
+		}
+	}
+
+	/**
+	 * @brief Returns the commit stamp read by the oldest snapshot
+	 *
+	 * @return std::uint64_t The stamp, or the stamp of the last write if there is no snapshot
+	 */
+	std::uint64_t oldest()
+	{
+		std::lock_guard<std::mutex> lock(snapshot_mutex);
+		return snapshots.empty() ? committed.load() : *snapshots.begin();
+	}
+
+	/**
+	 * @brief Unregisters a snapshot, used by its destructor
+	 *
+	 * @param stamp Commit stamp the snapshot reads at
+	 */
+	void release(const std::uint64_t stamp)
+	{
+		std::lock_guard<std::mutex> lock(snapshot_mutex);
+		snapshots.erase(snapshots.find(stamp));
+	}
+
+	/**
+	 * @brief Reclaims a retired version, used as callback for the epoch manager
+	 *
+	 * @param version Version to reclaim
+	 */
+	static void reclaim_version(void *version)
+	{
+		delete static_cast<Version *>(version);
+	}
+
+	/**
+	 * @brief Reclaims a chain together with the versions still on it
+	 *
+	 * @param chain Chain to reclaim
+	 */
+	static void reclaim_chain(void *chain)
+	{
+		Version *version = static_cast<Chain *>(chain)->newest.load();
+		while (version != nullptr) {
+			Version *older = version->older.load();
+			delete version;
+			version = older;
+		}
+		delete static_cast<Chain *>(chain);
+	}
+
+	// Keys and their chains of versions
+	List list;
+
+	// Stamp of the last write committed, which versions stamped later are not yet part of
+	std::atomic<std::uint64_t> committed{0};
+
+	// Makes writers take turns
+	std::mutex write_mutex;
+
+	// Stamps of the snapshots not yet released
+	std::mutex snapshot_mutex;
+	std::multiset<std::uint64_t> snapshots;
+
+	std::atomic<size_t> live_keys{0};
+	std::atomic<size_t> version_count{0};
+
+	// Number of versions left behind from which all keys are swept
+	size_t collect_threshold{COLLECT_MIN};
+
+	// Keeps versions and chains cut by the writer until no reader can still be on them
+	EpochManager epochs;
+};
+} // namespace DM803
+
+#endif // MVCC_SKIP_LIST_HPP
@@ -0,0 +1,118 @@
+/**
+ * @file persistent_skip_list.cpp
+ * @brief Test program for the Persistent Skip List data structure
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Test program for the Skip List kept in a memory-mapped file, reading insert, search and delete
+ * commands from stdin in the same format as the Skip List test program, and in addition C to make
+ * a checkpoint. The list is opened from the given file, so a second run continues from where the
+ * first one left off. The Persistent Skip List itself is in persistent_skip_list.hpp.
+ */
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "persistent_skip_list.hpp"
+
+/**
+ * @brief Prints a helper message to stdout for how to use this program
+ *
+ * @param program First argument from the command line, i.e. argv[0]
+ */
+static void show_usage(const std::string& program)
+{
+	std::cout << "Usage: " << program << " <file> [<p>]\n"
+	          << "Arguments:\n"
+	          << "\tfile\t\tFile to keep the list in, created if it does not exist.\n"
+	          << "\tp \t\tOptional: Floating point constant between (0,1) defining number of\n"
+	          << "\t\t\telements that are level i or greater, for a new file. Default value\n"
+	          << "\t\t\tis 1/e = 0.36788.\n"
+	          << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	double p{0.36788};
+	if (argc < 2 || argc > 3) {
+		show_usage(argv[0]);
+		return 1;
+	}
+	if (argc > 2) {
+		try {
+			p = std::stod(argv[2]);
+		} catch (std::exception &e) {
+			p = 0.0;
+		}
+		if (p <= 0.0 || p >= 1.0) {
+			show_usage(argv[0]);
+			std::cerr << "Error: the value of p must be in the range (0,1).\n";
+			return 1;
+		}
+	}
+
+	DM803::PersistentSkipList<int, int> l(argv[1], p);
+	if (!l.is_open()) {
+		std::cerr << "Error: cannot open '" << argv[1] << "' as a list of int keys and values.\n";
+		return 1;
+	}
+	if (l.recovered()) {
+		std::cerr << "'" << argv[1] << "' was not closed cleanly, recovered " << l.size() << " keys.\n";
+	}
+
+	std::string line{};
+	std::string space_delimiter{" "};
+	std::string operation{};
+	int key{};
+
+	while(std::getline(std::cin, line)) {
+		operation = line.substr(0, line.find(space_delimiter));
+		try {
+			key = std::stoi(line.substr(line.find(space_delimiter) + space_delimiter.length()));
+		} catch (std::invalid_argument &e) {
+			key = -1;
+		}
+		if (operation == "I" || operation == "i") {
+			std::pair<int, bool> inserted(l.insert(key, key));
+			if (inserted.second) {
+				std::cout << "S - inserted '" << key << "'. Comparisons: " << inserted.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			} else {
+				std::cout << "F - key '" << key << "' already present. Comparisons: " << inserted.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			}
+		} else if (operation == "S" || operation == "s") {
+			std::pair<int, bool> key_found(l.search(key));
+			if (key_found.second) {
+				std::cout << "S - found '" << key << "'. Comparisons: " << key_found.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			} else {
+				std::cout << "F - key '" << key << "' not present. Comparisons: " << key_found.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			}
+		} else if (operation == "D" || operation == "d") {
+			std::pair<int, bool> removed(l.remove(key));
+			if (removed.second) {
+				std::cout << "S - deleted '" << key << "'. Comparisons: " << removed.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			} else {
+				std::cout << "F - key '" << key << "' not present. Comparisons: " << removed.first;
+				std::cout << ". List size: " << l.size() << std::endl;
+			}
+		} else if (operation == "C" || operation == "c") {
+			if (l.checkpoint()) {
+				std::cout << "S - checkpoint. List size: " << l.size() << std::endl;
+			} else {
+				std::cout << "F - checkpoint failed. List size: " << l.size() << std::endl;
+			}
+		} else if (operation == "Q" || operation == "q") {
+			return 0;
+		} else {
+			std::cout << "F - " << operation << " command unknown, ignored" << std::endl;
+		}
+	}
+	return 0;
+}
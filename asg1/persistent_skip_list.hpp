@@ -0,0 +1,769 @@
+/**
+ * @file persistent_skip_list.hpp
+ * @brief Header-only implementation of a Skip List kept in a memory-mapped file
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * A Skip List with the same search, insert and delete interface as skip_list.hpp, whose nodes live
+ * in a file mapped into memory, so that opening an existing list takes a single mmap() instead of
+ * inserting every key again. Nodes are linked by their offsets in the file rather than by
+ * pointers, so the mapping may move when the file grows. Keys and values are copied into the file
+ * byte for byte and must therefore be trivially copyable.
+ *
+ * The file starts with a header page holding the parameters of the list, followed by records that
+ * are only ever appended, never moved or reused. The first record is the sentinel, every insert
+ * and update appends a node record, and every delete appends a tombstone record with the key
+ * deleted, so the records form a log of all modifications in order. Each record carries a checksum of its kind,
+ * level, key and value, but not of its forward links, which are the only bytes ever written in
+ * place.
+ *
+ * checkpoint() flushes the records to disk and then marks the header clean, together with the
+ * size of the list, the number of levels in use and the end of the records. The first
+ * modification after a checkpoint marks the header dirty and flushes it before changing anything
+ * else. Opening a clean file trusts the links as they are, which takes constant time. Opening a
+ * dirty file, left behind by a process that stopped between checkpoints, recovers the list from
+ * the log instead: the records are read up to the first one that is incomplete or fails its
+ * checksum, the last record for each key decides if it is present, and all links are rebuilt
+ * from the present nodes in sorted order, in O(n log n) time. A process that stops anywhere loses
+ * at most the operation it was making, and a machine that stops loses nothing up to the last
+ * checkpoint.
+ *
+ * Deleted nodes and tombstones keep their space in the file, so the file grows with the number of
+ * modifications rather than the size of the list.
+ */
+#ifndef PERSISTENT_SKIP_LIST_HPP
+#define PERSISTENT_SKIP_LIST_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "level_generator.hpp"
+
+namespace DM803
+{
+template<class Key, class Value, class Compare = std::less<Key>>
+class PersistentSkipList
+{
+	static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+	              "keys and values are stored in the file byte for byte and must be trivially copyable");
+
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using key_compare = Compare;
+	using size_type = std::size_t;
+
+	// Default upper bound for the number of levels of a node
+	static constexpr int LEVEL_CAP{32};
+
+	// Largest supported upper bound for the number of levels of a node
+	static constexpr int MAX_LEVEL_CAP{64};
+
+	/**
+	 * @brief Opens the Persistent Skip List stored in the given file, or creates an empty one if
+	 *        the file does not exist or is empty
+	 *
+	 * The list must not be used if is_open() returns false afterwards.
+	 *
+	 * @param path Path of the file
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater,
+	 *          only used when creating a new list, as an existing one keeps its own
+	 * @param level_cap Upper bound for the number of possible forward pointers, only used when
+	 *                  creating a new list
+	 * @param comp Comparator defining the order of the keys, which must be the same every time
+	 *             the file is opened
+	 */
+	explicit PersistentSkipList(const std::string &path, const double p=0.5, const int level_cap=LEVEL_CAP,
+	                            const Compare &comp=Compare())
+		: level_cap(std::max(1, std::min(level_cap, MAX_LEVEL_CAP))),
+		  p(p),
+		  comp(comp),
+		  rng(std::random_device{}()),
+		  level_distribution(p, this->level_cap)
+	{
+		fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+		struct stat status;
+		if (fd < 0 || fstat(fd, &status) != 0) {
+			close_file();
+			return;
+		}
+		bool created{status.st_size == 0};
+		if (created && ftruncate(fd, INITIAL_CAPACITY) != 0) {
+			close_file();
+			return;
+		}
+		capacity = created ? INITIAL_CAPACITY : static_cast<size_t>(status.st_size);
+		if (capacity < HEADER_SIZE) {
+			close_file();
+			return;
+		}
+		void *memory = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (memory == MAP_FAILED) {
+			close_file();
+			return;
+		}
+		base = static_cast<char *>(memory);
+		if (created) {
+			create();
+		} else if (!load()) {
+			close_file();
+		}
+	}
+
+	PersistentSkipList(const PersistentSkipList &) = delete;
+	PersistentSkipList &operator=(const PersistentSkipList &) = delete;
+
+	/**
+	 * @brief Makes a checkpoint and closes the file
+	 *
+	 */
+	~PersistentSkipList()
+	{
+		if (is_open()) {
+			checkpoint();
+		}
+		close_file();
+	}
+
+	/**
+	 * @brief Tells if the file was opened, and, if it existed, held a list with keys and values
+	 *        of the same sizes as this one
+	 *
+	 * @return bool True if the list can be used
+	 */
+	bool is_open() const
+	{
+		return base != nullptr;
+	}
+
+	/**
+	 * @brief Tells if opening the file had to recover the list from the log of records, since it
+	 *        was not closed cleanly
+	 *
+	 * @return bool True if the list was recovered
+	 */
+	bool recovered() const
+	{
+		return was_recovered;
+	}
+
+	/**
+	 * @brief Searches the Persistent Skip List for the given key
+	 *
+	 * @param search_key Key to find
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was found, false otherwise
+	 */
+	std::pair<int, bool> search(const Key &search_key) const
+	{
+		Offset update[MAX_LEVEL_CAP];
+		Offset node{SENTINEL};
+		int comparisons(traverse_list(search_key, node, update));
+		if (node != SENTINEL) {
+			comparisons++;
+			if (equal(node, search_key)) {
+				return std::make_pair(comparisons, true);
+			}
+		}
+		return std::make_pair(comparisons, false);
+	}
+
+	/**
+	 * @brief Looks up the value stored for the given key
+	 *
+	 * The value is read-only, as the checksum of its record covers it. Use update() to change it.
+	 *
+	 * @param search_key Key to find
+	 * @return const Value* Pointer to the value in the mapped file, or null if the key is not
+	 *                      present. The pointer is valid until the next insert, update or remove,
+	 *                      which may move the mapping
+	 */
+	const Value *get(const Key &search_key) const
+	{
+		Offset update[MAX_LEVEL_CAP];
+		Offset node{SENTINEL};
+		traverse_list(search_key, node, update);
+		return node != SENTINEL && equal(node, search_key) ? &record(node)->value : nullptr;
+	}
+
+	/**
+	 * @brief Visits the elements with keys in [lo, hi] in order
+	 *
+	 * @param lo Smallest key to visit
+	 * @param hi Largest key to visit
+	 * @param visit Function called with the key and value of each element
+	 * @return size_t Number of elements visited
+	 */
+	template<class Visitor>
+	size_t range_scan(const Key &lo, const Key &hi, Visitor visit) const
+	{
+		Offset update[MAX_LEVEL_CAP];
+		Offset node{SENTINEL};
+		traverse_list(lo, node, update);
+		size_t visited{0};
+		for (; node != SENTINEL && !comp(hi, record(node)->key); node = forward(node)[0]) {
+			visit(record(node)->key, record(node)->value);
+			visited++;
+		}
+		return visited;
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Persistent Skip List
+	 *
+	 * @param search_key Key to insert
+	 * @param new_value Value to insert
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key and value was inserted,
+	 * 										false if key was already present
+	 */
+	std::pair<int, bool> insert(const Key &search_key, const Value &new_value)
+	{
+		Offset update[MAX_LEVEL_CAP];
+		Offset node{SENTINEL};
+		int comparisons(traverse_list(search_key, node, update));
+		if (node != SENTINEL) {
+			comparisons++;
+			if (equal(node, search_key)) {
+				return std::make_pair(comparisons, false);
+			}
+		}
+		mark_dirty();
+		int lvl{random_level()};
+		node = append(NODE, lvl, search_key, new_value);
+		// Linked bottom up, so the levels a node is linked in are always a prefix of its levels
+		for (size_t i = 0; i < static_cast<size_t>(std::min(lvl, max_level)); i++) {
+			forward(node)[i] = forward(update[i])[i];
+			forward(update[i])[i] = node;
+		}
+		list_size++;
+		if (static_cast <int> (std::floor(L(list_size))) > max_level && max_level < level_cap) {
+			increase_max_level_of_list();
+		}
+		return std::make_pair(comparisons, true);
+	}
+
+	/**
+	 * @brief Replaces the value stored for a key already in the Persistent Skip List
+	 *
+	 * Records are never changed once appended, so a node record with the new value is appended
+	 * and linked in place of the old one, at the same levels. Recovery keeps the last record for
+	 * every key, so the old record is ignored from then on.
+	 *
+	 * @param search_key Key to update
+	 * @param new_value Value to store
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if the value was replaced, false if key was not present
+	 */
+	std::pair<int, bool> update(const Key &search_key, const Value &new_value)
+	{
+		Offset update[MAX_LEVEL_CAP];
+		Offset node{SENTINEL};
+		int comparisons(traverse_list(search_key, node, update));
+		if (node != SENTINEL) {
+			comparisons++;
+			if (equal(node, search_key)) {
+				mark_dirty();
+				// The key and value are copied first, as they may point into the mapping, e.g. when
+				// taken from get(), and appending may move it
+				Key key(search_key);
+				Value value(new_value);
+				int lvl{static_cast<int>(record(node)->level)};
+				Offset replacement{append(NODE, lvl, key, value)};
+				for (size_t i = 0; i < static_cast<size_t>(std::min(lvl, max_level)); i++) {
+					forward(replacement)[i] = forward(node)[i];
+					forward(update[i])[i] = replacement;
+				}
+				return std::make_pair(comparisons, true);
+			}
+		}
+		return std::make_pair(comparisons, false);
+	}
+
+	/**
+	 * @brief Removes key and its value from the Persistent Skip List
+	 *
+	 * @param search_key Key to remove
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was removed, false if key was not present
+	 */
+	std::pair<int, bool> remove(const Key &search_key)
+	{
+		Offset update[MAX_LEVEL_CAP];
+		Offset node{SENTINEL};
+		int comparisons(traverse_list(search_key, node, update));
+		if (node != SENTINEL) {
+			comparisons++;
+			if (equal(node, search_key)) {
+				mark_dirty();
+				// The key and value are copied first, as appending may move the mapping
+				Key key(record(node)->key);
+				Value value(record(node)->value);
+				append(TOMBSTONE, 0, key, value);
+				int lvl{static_cast<int>(record(node)->level)};
+				for (size_t i = std::min(lvl, max_level); i > 0; i--) {
+					forward(update[i-1])[i-1] = forward(node)[i-1];
+				}
+				list_size--;
+				if (list_size > 0 && static_cast <int> (std::ceil(L(list_size))) < max_level) {
+					if (max_level > 1) {
+						max_level--;
+					}
+				}
+				return std::make_pair(comparisons, true);
+			}
+		}
+		return std::make_pair(comparisons, false);
+	}
+
+	/**
+	 * @brief Flushes all records to disk and marks the file clean, so that opening it again
+	 *        needs no recovery and no modification made so far can be lost
+	 *
+	 * @return bool True if the file was flushed, false if the operating system reported an error
+	 */
+	bool checkpoint()
+	{
+		if (msync(base, end, MS_SYNC) != 0) {
+			return false;
+		}
+		Header *h = header();
+		h->end = end;
+		h->list_size = list_size;
+		h->max_level = max_level;
+		h->clean = 1;
+		return msync(base, HEADER_SIZE, MS_SYNC) == 0;
+	}
+
+	/**
+	 * @brief Returns the number of elements in the Persistent Skip List
+	 *
+	 * @return size_t
+	 */
+	size_t size() const
+	{
+		return list_size;
+	}
+
+	bool empty() const
+	{
+		return list_size == 0;
+	}
+
+	/**
+	 * @brief Returns the number of bytes of the file taken up by the header and records
+	 *
+	 * @return size_t
+	 */
+	size_t file_bytes() const
+	{
+		return end;
+	}
+
+	key_compare key_comp() const
+	{
+		return comp;
+	}
+
+	/**
+	 * @brief Prints the keys of the Persistent Skip List in order
+	 *
+	 * @param s Stream to print to
+	 * @param l Persistent Skip List to print
+	 * @return std::ostream& The stream
+	 */
+	friend std::ostream &operator<<(std::ostream &s, const PersistentSkipList &l)
+	{
+		for (Offset node = l.forward(SENTINEL)[0]; node != SENTINEL; node = l.forward(node)[0]) {
+			if (node != l.forward(SENTINEL)[0]) {
+				s << "->";
+			}
+			s << "[" << l.record(node)->key << "]";
+		}
+		return s;
+	}
+
+private:
+	// Offset of a record from the start of the file
+	using Offset = std::uint64_t;
+
+	static constexpr char MAGIC[8]{'D', 'M', '8', '0', '3', 'P', 'S', 'L'};
+	static constexpr std::uint32_t VERSION{1};
+
+	// The header takes up the first page, so the records start page aligned
+	static constexpr size_t HEADER_SIZE{4096};
+	static constexpr size_t INITIAL_CAPACITY{1 << 20};
+
+	// Kinds of records
+	static constexpr std::uint32_t NODE{1};
+	static constexpr std::uint32_t TOMBSTONE{2};
+	static constexpr std::uint32_t SENTINEL_NODE{3};
+
+	// The sentinel is the first record
+	static constexpr Offset SENTINEL{HEADER_SIZE};
+
+	struct Header
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t key_size;
+		std::uint32_t value_size;
+		std::int32_t level_cap;
+		double p;
+
+		// State at the last checkpoint, only valid if clean is set
+		std::uint64_t end;
+		std::uint64_t list_size;
+		std::int32_t max_level;
+		std::uint32_t clean;
+	};
+
+	// A record is followed by level forward links, at the next multiple of 8 bytes
+	struct Record
+	{
+		std::uint32_t kind;
+		std::uint32_t level;
+		std::uint64_t checksum;
+		Key key;
+		Value value;
+	};
+
+	static_assert(alignof(Record) <= 8, "keys and values may be aligned to at most 8 bytes");
+
+	static constexpr size_t LINKS{(sizeof(Record) + 7) / 8 * 8};
+
+	static size_t record_size(const size_t level)
+	{
+		return LINKS + level * sizeof(Offset);
+	}
+
+	Header *header() const
+	{
+		return reinterpret_cast<Header *>(base);
+	}
+
+	Record *record(const Offset offset) const
+	{
+		return reinterpret_cast<Record *>(base + offset);
+	}
+
+	Offset *forward(const Offset offset) const
+	{
+		return reinterpret_cast<Offset *>(base + offset + LINKS);
+	}
+
+	bool less(const Offset node, const Key &search_key) const
+	{
+		return comp(record(node)->key, search_key);
+	}
+
+	bool equal(const Offset node, const Key &search_key) const
+	{
+		return !comp(search_key, record(node)->key);
+	}
+
+	/**
+	 * @brief Computes the FNV-1a hash of the kind, level, key and value of a record
+	 *
+	 * @param r Record to hash
+	 * @return std::uint64_t The hash
+	 */
+	static std::uint64_t checksum(const Record *r)
+	{
+		std::uint64_t hash{14695981039346656037ULL};
+		auto add = [&hash](const void *bytes, const size_t n) {
+			for (size_t i = 0; i < n; i++) {
+				hash = (hash ^ static_cast<const unsigned char *>(bytes)[i]) * 1099511628211ULL;
+			}
+		};
+		add(&r->kind, sizeof(r->kind));
+		add(&r->level, sizeof(r->level));
+		add(&r->key, sizeof(Key));
+		add(&r->value, sizeof(Value));
+		return hash;
+	}
+
+	/**
+	 * @brief Writes the header and sentinel of a new list to the freshly created file
+	 *
+	 */
+	void create()
+	{
+		Header *h = header();
+		std::memcpy(h->magic, MAGIC, sizeof(MAGIC));
+		h->version = VERSION;
+		h->key_size = sizeof(Key);
+		h->value_size = sizeof(Value);
+		h->level_cap = level_cap;
+		h->p = p;
+		h->clean = 0;
+		Record *sentinel = record(SENTINEL);
+		sentinel->kind = SENTINEL_NODE;
+		sentinel->level = level_cap;
+		for (size_t i = 0; i < static_cast<size_t>(level_cap); i++) {
+			forward(SENTINEL)[i] = SENTINEL;
+		}
+		end = SENTINEL + record_size(level_cap);
+		checkpoint();
+	}
+
+	/**
+	 * @brief Checks the header of an existing file and takes over its state, recovering the list
+	 *        if it was not closed cleanly
+	 *
+	 * @return bool True if the file holds a list with keys and values of the right sizes
+	 */
+	bool load()
+	{
+		const Header *h = header();
+		if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0 || h->version != VERSION
+		    || h->key_size != sizeof(Key) || h->value_size != sizeof(Value)
+		    || h->level_cap < 1 || h->level_cap > MAX_LEVEL_CAP
+		    || capacity < SENTINEL + record_size(h->level_cap)) {
+			return false;
+		}
+		level_cap = h->level_cap;
+		p = h->p;
+		level_distribution = GeometricLevels(p, level_cap);
+		// A clean header is only trusted if its state fits the file, and recovery rebuilds it otherwise
+		if (h->clean && h->end <= capacity && h->max_level >= 1 && h->max_level <= level_cap) {
+			end = h->end;
+			list_size = h->list_size;
+			max_level = h->max_level;
+		} else {
+			recover();
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Rebuilds the list from the log of records after the file was not closed cleanly
+	 *
+	 * The records are read until the first one that does not fit in the file, has an unknown
+	 * kind or level, or fails its checksum, and the space from there on is cleared, so that no
+	 * record left behind there can be read as part of the log later. The records are then
+	 * sorted by key, keeping the order of the log among equal keys, and every node that is the
+	 * last record for its key is linked at all of its levels.
+	 */
+	void recover()
+	{
+		std::vector<Offset> records;
+		Offset offset{SENTINEL + record_size(level_cap)};
+		while (offset + LINKS <= capacity) {
+			const Record *r = record(offset);
+			bool valid_level{r->kind == NODE ? r->level >= 1 && r->level <= static_cast<std::uint32_t>(level_cap)
+			                                 : r->kind == TOMBSTONE && r->level == 0};
+			if (!valid_level || offset + record_size(r->level) > capacity || r->checksum != checksum(r)) {
+				break;
+			}
+			records.push_back(offset);
+			offset += record_size(r->level);
+		}
+		end = offset;
+		std::memset(base + end, 0, capacity - end);
+
+		std::stable_sort(records.begin(), records.end(), [this](const Offset a, const Offset b) {
+			return comp(record(a)->key, record(b)->key);
+		});
+		Offset last[MAX_LEVEL_CAP];
+		std::fill(last, last + level_cap, SENTINEL);
+		list_size = 0;
+		for (size_t i = 0; i < records.size(); i++) {
+			Offset node{records[i]};
+			bool last_for_key{i + 1 == records.size() || comp(record(node)->key, record(records[i+1])->key)};
+			if (!last_for_key || record(node)->kind != NODE) {
+				continue;
+			}
+			for (size_t j = 0; j < record(node)->level; j++) {
+				forward(last[j])[j] = node;
+				last[j] = node;
+			}
+			list_size++;
+		}
+		for (size_t j = 0; j < static_cast<size_t>(level_cap); j++) {
+			forward(last[j])[j] = SENTINEL;
+		}
+		max_level = 1;
+		if (list_size > 0) {
+			max_level = std::max(1, std::min(level_cap, static_cast<int>(std::floor(L(list_size)))));
+		}
+		was_recovered = true;
+		checkpoint();
+	}
+
+	/**
+	 * @brief Marks the header dirty on the first modification after a checkpoint, and flushes it
+	 *        before the modification is made
+	 *
+	 */
+	void mark_dirty()
+	{
+		if (header()->clean) {
+			header()->clean = 0;
+			msync(base, HEADER_SIZE, MS_SYNC);
+		}
+	}
+
+	/**
+	 * @brief Appends a record to the file, growing it if needed
+	 *
+	 * The forward links of a node are set to the sentinel. Throws std::bad_alloc if the file
+	 * cannot grow, like running out of memory for the nodes of the Skip List.
+	 *
+	 * @param kind Kind of record
+	 * @param level Number of forward links
+	 * @param key Key of the record
+	 * @param value Value of the record
+	 * @return Offset Offset of the record
+	 */
+	Offset append(const std::uint32_t kind, const int level, const Key &key, const Value &value)
+	{
+		size_t bytes{record_size(level)};
+		if (end + bytes > capacity) {
+			grow(std::max(2 * capacity, end + bytes));
+		}
+		Offset offset{end};
+		Record *r = record(offset);
+		r->kind = kind;
+		r->level = level;
+		std::memcpy(static_cast<void *>(&r->key), &key, sizeof(Key));
+		std::memcpy(static_cast<void *>(&r->value), &value, sizeof(Value));
+		r->checksum = checksum(r);
+		for (size_t i = 0; i < static_cast<size_t>(level); i++) {
+			forward(offset)[i] = SENTINEL;
+		}
+		end += bytes;
+		return offset;
+	}
+
+	/**
+	 * @brief Extends the file and its mapping, which may move the mapping
+	 *
+	 * @param new_capacity Size of the file in bytes
+	 */
+	void grow(const size_t new_capacity)
+	{
+		if (ftruncate(fd, new_capacity) != 0) {
+			throw std::bad_alloc();
+		}
+		void *memory = mremap(base, capacity, new_capacity, MREMAP_MAYMOVE);
+		if (memory == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+		base = static_cast<char *>(memory);
+		capacity = new_capacity;
+	}
+
+	void close_file()
+	{
+		if (base != nullptr) {
+			munmap(base, capacity);
+			base = nullptr;
+		}
+		if (fd >= 0) {
+			::close(fd);
+			fd = -1;
+		}
+	}
+
+	/**
+	 * @brief Traverse the Persistent Skip List until an element with key >= search key is found
+	 *
+	 * @param search_key Key to search for
+	 * @param node Reference to the offset receiving the first node with key >= search key
+	 * @param update Receives the last node visited at each level
+	 * @return int Number of comparisons made during traversal
+	 */
+	int traverse_list(const Key &search_key, Offset &node, Offset *update) const
+	{
+		node = SENTINEL;
+		int comparisons{0};
+		bool node_not_sentinel{false};
+		bool key_less_than_search_key{false};
+		for (size_t i = max_level; i > 0; i--) {
+			while ((node_not_sentinel = forward(node)[i-1] != SENTINEL)
+			      && (key_less_than_search_key = less(forward(node)[i-1], search_key))) {
+				comparisons++;
+				node = forward(node)[i-1];
+			}
+			if (node_not_sentinel && !key_less_than_search_key) {
+				comparisons++;
+			}
+			update[i-1] = node;
+		}
+		node = forward(node)[0];
+		return comparisons;
+	}
+
+	/**
+	 * @brief Generates a random integer in the range [1,level cap] to use as the level for a
+	 *        new node
+	 *
+	 * @return int Positive integer in range [1,level cap]
+	 */
+	int random_level()
+	{
+		return level_distribution(rng);
+	}
+
+	double L(const size_t n) const
+	{
+		return std::log2(n) / (-std::log2(p));
+	}
+
+	void increase_max_level_of_list()
+	{
+		int level{max_level};
+		Offset r{SENTINEL};
+		for (Offset q = forward(r)[level-1]; q != SENTINEL; q = forward(q)[level-1]) {
+			if (record(q)->level > static_cast<std::uint32_t>(level)) {
+				forward(r)[level] = q;
+				r = q;
+			}
+		}
+		forward(r)[level] = SENTINEL;
+		max_level++;
+	}
+
+	int fd{-1};
+
+	// Start and size of the mapping of the whole file
+	char *base{nullptr};
+	size_t capacity{0};
+
+	// Offset past the last record
+	size_t end{0};
+
+	size_t list_size{0};
+	int level_cap;
+	int max_level{1};
+	double p;
+	bool was_recovered{false};
+
+	Compare comp;
+
+	Xoshiro256 rng;
+	GeometricLevels level_distribution;
+};
+} // namespace DM803
+
+#endif // PERSISTENT_SKIP_LIST_HPP
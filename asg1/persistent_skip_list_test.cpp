@@ -0,0 +1,176 @@
+/**
+ * @file persistent_skip_list_test.cpp
+ * @brief Crash recovery test for the Persistent Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Makes random inserts, updates and deletes in a Persistent Skip List, checking every result
+ * against a std::map, and checks that the list survives being closed and opened again. Then forks
+ * a child that makes more changes without a checkpoint and stops with _exit(), as a process
+ * that is killed would, and checks that opening the file again recovers every change the child
+ * made.
+ */
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "persistent_skip_list.hpp"
+
+using List = DM803::PersistentSkipList<int, int>;
+
+/**
+ * @brief Prints a helper message to stdout for how to use this program
+ *
+ * @param program First argument from the command line, i.e. argv[0]
+ */
+static void show_usage(const std::string& program)
+{
+	std::cout << "Usage: " << program << " <file> [<operations>]\n"
+	          << "Arguments:\n"
+	          << "\tfile\t\tFile to keep the list in, which is removed first.\n"
+	          << "\toperations\tOptional: Number of operations per phase. Default value is 100000.\n"
+	          << std::endl;
+}
+
+/**
+ * @brief Checks that the list holds exactly the keys and values of the reference map, and if it
+ *        was recovered when opened
+ *
+ * @param l List to check
+ * @param reference Expected contents
+ * @param recovered True if the list should have been recovered
+ * @param phase Name of the phase, used in error messages
+ * @return bool True if the list passed the check
+ */
+static bool check_list(const List &l, const std::map<int, int> &reference, const bool recovered,
+                       const std::string &phase)
+{
+	auto expected = reference.begin();
+	bool matches{true};
+	size_t visited{l.range_scan(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+	                            [&](const int key, const int value) {
+		matches = matches && expected != reference.end() && expected->first == key && expected->second == value;
+		if (expected != reference.end()) {
+			++expected;
+		}
+	})};
+	if (!matches || visited != reference.size() || l.size() != reference.size() || l.recovered() != recovered) {
+		std::cout << "F - " << phase << ": expected " << reference.size() << " keys, visited " << visited
+		          << (matches ? "" : ", contents differ") << ", size() reports " << l.size()
+		          << (l.recovered() ? ", recovered" : ", not recovered") << std::endl;
+		return false;
+	}
+	std::cout << "S - " << phase << ": " << visited << " keys" << (recovered ? ", recovered" : "") << std::endl;
+	return true;
+}
+
+/**
+ * @brief Makes random inserts, updates and deletes in a list and its reference, and checks each
+ *        result
+ *
+ * @param l List to change
+ * @param reference Reference to change alike
+ * @param operations Number of operations
+ * @param rng Random number generator
+ * @return bool True if every result agreed with the reference
+ */
+static bool churn(List &l, std::map<int, int> &reference, const int operations, std::mt19937 &rng)
+{
+	std::uniform_int_distribution<> key_distribution(0, operations);
+	for (int i = 0; i < operations; i++) {
+		int key{key_distribution(rng)};
+		if (rng() % 3 != 0) {
+			// A key already present gets the new value through update()
+			bool inserted{reference.emplace(key, i).second};
+			if (l.insert(key, i).second != inserted) {
+				std::cout << "F - insert of '" << key << "' after " << i << " operations" << std::endl;
+				return false;
+			}
+			if (!inserted && (!l.update(key, i).second || *l.get(key) != i)) {
+				std::cout << "F - update of '" << key << "' after " << i << " operations" << std::endl;
+				return false;
+			}
+			reference[key] = i;
+		} else if (l.remove(key).second != (reference.erase(key) > 0)) {
+			std::cout << "F - remove of '" << key << "' after " << i << " operations" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	int operations{100000};
+	try {
+		if (argc > 2) {
+			operations = std::stoi(argv[2]);
+		}
+	} catch (std::exception &e) {
+		operations = 0;
+	}
+	if (argc < 2 || argc > 3 || operations < 1) {
+		show_usage(argv[0]);
+		return 1;
+	}
+	std::remove(argv[1]);
+
+	std::map<int, int> reference;
+	std::mt19937 rng(13);
+	bool passed{true};
+	{
+		List l(argv[1]);
+		if (!l.is_open()) {
+			std::cout << "F - cannot open '" << argv[1] << "'" << std::endl;
+			return 1;
+		}
+		passed = churn(l, reference, operations / 2, rng) && l.checkpoint()
+		         && churn(l, reference, operations / 2, rng) && check_list(l, reference, false, "random operations");
+	}
+	{
+		List reopened(argv[1]);
+		passed = passed && check_list(reopened, reference, false, "reopen");
+	}
+
+	// The child stops without a checkpoint, as a killed process would, after making the same
+	// changes as are made to the reference here
+	std::mt19937 child_rng(rng);
+	std::map<int, int> child_reference(reference);
+	pid_t child{fork()};
+	if (child == 0) {
+		List l(argv[1]);
+		bool changed{l.is_open() && churn(l, child_reference, operations, child_rng)};
+		_exit(changed ? 0 : 1);
+	}
+	int status{};
+	if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		std::cout << "F - child making changes without a checkpoint did not finish" << std::endl;
+		return 1;
+	}
+	// Replays the changes the child made, whose results it has checked already
+	std::uniform_int_distribution<> key_distribution(0, operations);
+	for (int i = 0; i < operations; i++) {
+		int key{key_distribution(rng)};
+		if (rng() % 3 != 0) {
+			reference[key] = i;
+		} else {
+			reference.erase(key);
+		}
+	}
+	{
+		List recovered(argv[1]);
+		passed = recovered.is_open() && check_list(recovered, reference, true, "stop without checkpoint") && passed;
+	}
+	List reopened(argv[1]);
+	passed = reopened.is_open() && check_list(reopened, reference, false, "reopen after recovery") && passed;
+	return passed ? 0 : 1;
+}
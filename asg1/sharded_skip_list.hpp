@@ -0,0 +1,489 @@
+/**
+ * @file sharded_skip_list.hpp
+ * @brief Range-partitioned Skip List with one lock per shard for many writing threads
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Ordered map for many threads at once, made of single-threaded Skip Lists, the shards, each
+ * holding one range of keys behind its own lock. A range table sorted by the smallest key of each
+ * shard routes every key to its shard with a binary search, so threads working on different
+ * ranges never touch the same lock or the same nodes.
+ *
+ * Every shard counts the writes made to it, halved at every check, and every REBALANCE_INTERVAL
+ * writes to a shard the table is checked for shards that run hot. A shard taking more than twice
+ * the share of the writes that every shard would have with the largest number of shards evenly
+ * loaded is split at its median key with SkipList::split(). When the table is full, the coldest
+ * two neighbouring shards are first merged with SkipList::concat(), so the boundaries follow the
+ * writes. Both take O(log n) expected time and only lock the shards
+ * involved. The table itself is never changed in place but replaced, and the old one is handed to
+ * an epoch manager, so routing needs no lock. A thread that routed a key with an old table finds
+ * out when it holds the lock of the shard, which no longer covers the key, and routes it again.
+ *
+ * Range scans visit the shards in key order, locking one at a time, so every shard is scanned
+ * consistently, but writes to a shard not yet reached may be seen.
+ */
+#ifndef SHARDED_SKIP_LIST_HPP
+#define SHARDED_SKIP_LIST_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "epoch_reclamation.hpp"
+#include "skip_list.hpp"
+
+namespace DM803
+{
+template<class Key, class Value, class Compare = std::less<Key>>
+class ShardedSkipList
+{
+	using List = SkipList<Key, Value, Compare>;
+
+	struct Shard
+	{
+		Shard(List &&list, const std::optional<Key> &hi)
+			: list(std::move(list)),
+			  hi(hi)
+		{
+		}
+
+		std::mutex mutex;
+
+		List list;
+
+		// Key the next shard starts from, or empty for the last shard. The smallest key of a
+		// shard never changes, while the largest grows when the next shard is merged into it
+		// and shrinks when it is split
+		std::optional<Key> hi;
+
+		// Set once the shard has been merged into the one before it
+		bool merged{false};
+
+		// Writes made to the shard, halved at every check for hot shards
+		std::atomic<size_t> writes{0};
+	};
+
+	/**
+	 * Range table, where shard i + 1 starts from key bounds[i]
+	 */
+	struct Table
+	{
+		std::vector<Key> bounds;
+		std::vector<Shard *> shards;
+	};
+
+public:
+	// Number of writes to a shard between two checks for hot shards
+	static constexpr size_t REBALANCE_INTERVAL{1024};
+
+	// Least number of keys of a shard that is split
+	static constexpr size_t MIN_SPLIT_SIZE{256};
+
+	// Default largest number of shards
+	static constexpr size_t MAX_SHARDS{64};
+
+	/**
+	 * @brief Constructs a new Sharded Skip List object
+	 *
+	 * @param bounds Keys the shards after the first start from, in increasing order, to start
+	 *               out with more than one shard
+	 * @param max_shards Largest number of shards
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater
+	 * @param level_cap Upper bound for the number of possible forward pointers
+	 * @param comp Comparator defining the order of the keys
+	 */
+	explicit ShardedSkipList(const std::vector<Key> &bounds={}, const size_t max_shards=MAX_SHARDS,
+	                         const double p=0.5, const int level_cap=List::LEVEL_CAP,
+	                         const Compare &comp=Compare())
+		: max_shards(std::max<size_t>(1, max_shards)),
+		  comp(comp)
+	{
+		Table *first = new Table{bounds, {}};
+		for (size_t i = 0; i <= bounds.size(); i++) {
+			std::optional<Key> hi;
+			if (i < bounds.size()) {
+				hi = bounds[i];
+			}
+			first->shards.push_back(new Shard(List(p, level_cap, comp), hi));
+		}
+		table.store(first);
+	}
+
+	ShardedSkipList(const ShardedSkipList &) = delete;
+	ShardedSkipList &operator=(const ShardedSkipList &) = delete;
+
+	/**
+	 * @brief Destroys the Sharded Skip List object
+	 *
+	 * No other thread may access the list while it is destroyed. Tables and shards replaced
+	 * before are freed by the epoch manager.
+	 */
+	~ShardedSkipList()
+	{
+		reclaim_table_and_shards(table.load());
+	}
+
+	/**
+	 * @brief Searches the Sharded Skip List for the given key
+	 *
+	 * @param search_key Key to find
+	 * @param value If not null and the key is found, receives a copy of the value
+	 * @return bool True if the key was found, false otherwise
+	 */
+	bool search(const Key &search_key, Value *value=nullptr)
+	{
+		return with_shard(search_key, [&](Shard &shard) {
+			const Value *found = shard.list.get(search_key);
+			if (found != nullptr && value != nullptr) {
+				*value = *found;
+			}
+			return found != nullptr;
+		});
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Sharded Skip List
+	 *
+	 * @param search_key Key to insert
+	 * @param new_value Value to insert
+	 * @return bool True if key and value was inserted, false otherwise (e.g. key already present)
+	 */
+	bool insert(const Key &search_key, const Value &new_value)
+	{
+		bool check{false};
+		bool inserted{with_shard(search_key, [&](Shard &shard) {
+			check = count_write(shard);
+			return shard.list.insert(search_key, new_value).second;
+		})};
+		if (check) {
+			rebalance();
+		}
+		return inserted;
+	}
+
+	/**
+	 * @brief Inserts the key with the given value, or gives the key the value if present
+	 *
+	 * @param search_key Key to insert or update
+	 * @param new_value Value to store
+	 * @return bool True if the key was inserted, false if it was updated
+	 */
+	bool insert_or_assign(const Key &search_key, const Value &new_value)
+	{
+		bool check{false};
+		bool inserted{with_shard(search_key, [&](Shard &shard) {
+			check = count_write(shard);
+			return shard.list.insert_or_assign(search_key, new_value).second;
+		})};
+		if (check) {
+			rebalance();
+		}
+		return inserted;
+	}
+
+	/**
+	 * @brief Deletes the key, if present, from the Sharded Skip List
+	 *
+	 * @param search_key Key to be deleted
+	 * @return bool True if key was found and deleted, false otherwise
+	 */
+	bool remove(const Key &search_key)
+	{
+		bool check{false};
+		bool removed{with_shard(search_key, [&](Shard &shard) {
+			check = count_write(shard);
+			return shard.list.remove(search_key).second;
+		})};
+		if (check) {
+			rebalance();
+		}
+		return removed;
+	}
+
+	/**
+	 * @brief Visits the key-value pairs with keys in [lo, hi] in ascending key order, going on
+	 *        from each shard to the one holding the keys from where it ends
+	 *
+	 * The visitor runs while the lock of the shard holding the key is held, so it must not call
+	 * back into the list.
+	 *
+	 * @param lo Smallest key to visit
+	 * @param hi Largest key to visit
+	 * @param visit Callback invoked as visit(key, value)
+	 * @return size_t Number of pairs visited
+	 */
+	template<class Visitor>
+	size_t range_scan(const Key &lo, const Key &hi, Visitor visit)
+	{
+		size_t visited{0};
+		std::optional<Key> from{lo};
+		while (from && !comp(hi, *from)) {
+			from = with_shard(*from, [&](Shard &shard) {
+				visited += shard.list.range_scan(*from, hi, std::ref(visit));
+				return shard.hi;
+			});
+		}
+		return visited;
+	}
+
+	/**
+	 * @brief Visits every key-value pair in ascending key order, as range_scan() does
+	 *
+	 * @param visit Callback invoked as visit(key, value)
+	 */
+	template<class Visitor>
+	void for_each(Visitor visit)
+	{
+		EpochManager::Guard guard(epochs);
+
+		// The first shard is never merged into another, so it needs no routing
+		Shard *first = table.load(std::memory_order_acquire)->shards.front();
+		std::optional<Key> from;
+		{
+			std::lock_guard<std::mutex> lock(first->mutex);
+			for (auto &pair : first->list) {
+				visit(pair.first, pair.second);
+			}
+			from = first->hi;
+		}
+		while (from) {
+			from = with_shard(*from, [&](Shard &shard) {
+				for (auto it = shard.list.lower_bound(*from); it != shard.list.end(); ++it) {
+					visit(it->first, it->second);
+				}
+				return shard.hi;
+			});
+		}
+	}
+
+	/**
+	 * @brief Returns the number of elements in the Sharded Skip List
+	 *
+	 * The count is exact when no operation is in progress and approximate otherwise.
+	 *
+	 * @return size_t
+	 */
+	size_t size()
+	{
+		EpochManager::Guard guard(epochs);
+
+		size_t total{0};
+		for (Shard *shard : table.load(std::memory_order_acquire)->shards) {
+			std::lock_guard<std::mutex> lock(shard->mutex);
+			total += shard->list.size();
+		}
+		return total;
+	}
+
+	/**
+	 * @brief Returns the number of shards the keys are currently spread over
+	 *
+	 * @return size_t
+	 */
+	size_t shards()
+	{
+		EpochManager::Guard guard(epochs);
+
+		return table.load(std::memory_order_acquire)->shards.size();
+	}
+
+private:
+	/**
+	 * @brief Routes a key to its shard and runs an operation on the shard with its lock held,
+	 *        routing again if the shard turns out to no longer cover the key
+	 *
+	 * @param search_key Key to route
+	 * @param operation Callback invoked as operation(shard)
+	 * @return The result of the operation
+	 */
+	template<class Operation>
+	auto with_shard(const Key &search_key, Operation operation)
+	{
+		EpochManager::Guard guard(epochs);
+
+		while (true) {
+			const Table *current = table.load(std::memory_order_acquire);
+			size_t i{static_cast<size_t>(std::upper_bound(current->bounds.begin(), current->bounds.end(), search_key, comp)
+			                             - current->bounds.begin())};
+			Shard *shard = current->shards[i];
+			std::lock_guard<std::mutex> lock(shard->mutex);
+			if (!shard->merged && (!shard->hi || comp(search_key, *shard->hi))) {
+				return operation(*shard);
+			}
+		}
+	}
+
+	/**
+	 * @brief Counts a write to a shard. Must be called with the lock of the shard held
+	 *
+	 * @param shard Shard written to
+	 * @return bool True if the table is due to be checked for hot shards
+	 */
+	static bool count_write(Shard &shard)
+	{
+		return (shard.writes.fetch_add(1, std::memory_order_relaxed) + 1) % REBALANCE_INTERVAL == 0;
+	}
+
+	/**
+	 * @brief Splits the hottest shard if it takes more than twice the share of the writes it
+	 *        would have with max shards evenly loaded, merging the coldest two neighbouring
+	 *        shards first if the table is full and they take less than that share together,
+	 *        then halves the counts. Skipped if another thread is already at it
+	 *
+	 */
+	void rebalance()
+	{
+		std::unique_lock<std::mutex> rebalancing(rebalance_mutex, std::try_to_lock);
+		if (!rebalancing.owns_lock()) {
+			return;
+		}
+		EpochManager::Guard guard(epochs);
+
+		const Table *current = table.load();
+		const size_t n{current->shards.size()};
+		std::vector<size_t> writes(n);
+		size_t total{0};
+		size_t hottest{0};
+		for (size_t i = 0; i < n; i++) {
+			writes[i] = current->shards[i]->writes.load(std::memory_order_relaxed);
+			total += writes[i];
+			if (writes[i] > writes[hottest]) {
+				hottest = i;
+			}
+		}
+		bool splittable{false};
+		{
+			std::lock_guard<std::mutex> lock(current->shards[hottest]->mutex);
+			splittable = current->shards[hottest]->list.size() >= MIN_SPLIT_SIZE;
+		}
+		if (splittable && writes[hottest] * max_shards > 2 * total) {
+			if (n == max_shards) {
+				// Coldest two neighbours, which must not include the hottest shard
+				size_t coldest{n};
+				for (size_t i = 0; i + 1 < n; i++) {
+					if (i + 1 != hottest && i != hottest
+					    && (coldest == n || writes[i] + writes[i+1] < writes[coldest] + writes[coldest+1])) {
+						coldest = i;
+					}
+				}
+				if (coldest < n && (writes[coldest] + writes[coldest+1]) * max_shards < total) {
+					merge(coldest);
+					hottest -= hottest > coldest;
+				}
+			}
+			if (table.load()->shards.size() < max_shards) {
+				split(hottest);
+			}
+		}
+		for (Shard *shard : table.load()->shards) {
+			shard->writes.store(shard->writes.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @brief Splits a shard at its median key, unless it holds too few keys. Must be called
+	 *        while rebalancing
+	 *
+	 * @param i Position of the shard in the table
+	 */
+	void split(const size_t i)
+	{
+		const Table *current = table.load();
+		Shard *shard = current->shards[i];
+		std::lock_guard<std::mutex> lock(shard->mutex);
+		if (shard->list.size() < MIN_SPLIT_SIZE) {
+			return;
+		}
+		const Key median{shard->list.select(shard->list.size() / 2)->first};
+		Shard *upper = new Shard(shard->list.split(median), shard->hi);
+		upper->writes.store(shard->writes.load() / 2);
+		shard->writes.store(shard->writes.load() / 2);
+
+		Table *next = new Table(*current);
+		next->bounds.insert(next->bounds.begin() + i, median);
+		next->shards.insert(next->shards.begin() + i + 1, upper);
+		shard->hi = median;
+		// Published before the lock is released, so a thread finding the shard shrunk finds the
+		// new shard when it routes again
+		publish(current, next);
+	}
+
+	/**
+	 * @brief Merges a shard with the one after it. Must be called while rebalancing
+	 *
+	 * @param i Position of the first of the two shards in the table
+	 */
+	void merge(const size_t i)
+	{
+		const Table *current = table.load();
+		Shard *lower = current->shards[i];
+		Shard *upper = current->shards[i+1];
+		std::lock_guard<std::mutex> lower_lock(lower->mutex);
+		std::lock_guard<std::mutex> upper_lock(upper->mutex);
+		if (!lower->list.concat(upper->list)) {
+			return;
+		}
+		lower->hi = upper->hi;
+		lower->writes.fetch_add(upper->writes.load());
+		upper->merged = true;
+
+		Table *next = new Table(*current);
+		next->bounds.erase(next->bounds.begin() + i);
+		next->shards.erase(next->shards.begin() + i + 1);
+		publish(current, next);
+		epochs.retire(upper, &reclaim_shard);
+	}
+
+	/**
+	 * @brief Replaces the range table, retiring the old one. Must be called pinned
+	 *
+	 * @param current Table in use
+	 * @param next Table to use from now on
+	 */
+	void publish(const Table *current, Table *next)
+	{
+		table.store(next, std::memory_order_release);
+		epochs.retire(const_cast<Table *>(current), &reclaim_table);
+	}
+
+	static void reclaim_table(void *table)
+	{
+		delete static_cast<Table *>(table);
+	}
+
+	static void reclaim_shard(void *shard)
+	{
+		delete static_cast<Shard *>(shard);
+	}
+
+	static void reclaim_table_and_shards(Table *table)
+	{
+		for (Shard *shard : table->shards) {
+			delete shard;
+		}
+		delete table;
+	}
+
+	// Largest number of shards
+	const size_t max_shards{};
+
+	Compare comp;
+
+	std::atomic<Table *> table{nullptr};
+
+	// Makes threads that find hot shards take turns
+	std::mutex rebalance_mutex;
+
+	// Keeps replaced tables and merged shards until no thread can still be routing through them
+	EpochManager epochs;
+};
+} // namespace DM803
+
+#endif // SHARDED_SKIP_LIST_HPP
@@ -0,0 +1,162 @@
+/**
+ * @file simd_search.hpp
+ * @brief Compare-and-count search in small sorted arrays of keys
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Finds the position of a key in a short sorted array by counting the keys that order before it.
+ * For 32 and 64 bit integer keys under std::less, the keys are compared 4 or 8 at a time with
+ * AVX2 or SSE2 instructions, picked at runtime from what the processor supports, and the count is
+ * the population count of the comparison masks. Other keys and comparators fall back to a binary
+ * search, and other processors to a branch-free scalar count.
+ */
+#ifndef SIMD_SEARCH_HPP
+#define SIMD_SEARCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DM803_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace DM803
+{
+namespace simd
+{
+/**
+ * Tells if keys of the given type under the given comparator can be searched with the vector
+ * kernels, i.e. they are 32 or 64 bit signed integers compared with operator<
+ */
+template<class Key, class Compare>
+struct is_vectorizable
+	: std::integral_constant<bool, (std::is_same<Key, std::int32_t>::value || std::is_same<Key, std::int64_t>::value)
+	                               && (std::is_same<Compare, std::less<Key>>::value || std::is_same<Compare, std::less<>>::value)>
+{
+};
+
+/**
+ * @brief Counts the keys smaller than the given key with one comparison per key and no branches
+ *
+ * @param keys Sorted keys
+ * @param n Number of keys
+ * @param key Key to compare against
+ * @return std::size_t Number of keys < key
+ */
+template<class Integer>
+inline std::size_t count_less_scalar(const Integer *keys, const std::size_t n, const Integer key)
+{
+	std::size_t count{0};
+	for (std::size_t i = 0; i < n; i++) {
+		count += keys[i] < key;
+	}
+	return count;
+}
+
+#ifdef DM803_SIMD_X86
+// __builtin_cpu_init() must run first, as this may be initialised before any other constructor
+inline const bool HAS_AVX2{(__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0)};
+
+// The kernels compare a vector of keys at a time, and stop at the first vector that is not all
+// smaller than the key, since the keys after it are not smaller either
+
+__attribute__((target("avx2,popcnt")))
+inline std::size_t count_less_avx2(const std::int32_t *keys, const std::size_t n, const std::int32_t key)
+{
+	const __m256i needle{_mm256_set1_epi32(key)};
+	std::size_t count{0};
+	std::size_t i{0};
+	for (; i + 8 <= n; i += 8) {
+		__m256i lanes{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i))};
+		unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, lanes)));
+		count += __builtin_popcount(mask);
+		if (mask != 0xff) {
+			return count;
+		}
+	}
+	return count + count_less_scalar(keys + i, n - i, key);
+}
+
+__attribute__((target("avx2,popcnt")))
+inline std::size_t count_less_avx2(const std::int64_t *keys, const std::size_t n, const std::int64_t key)
+{
+	const __m256i needle{_mm256_set1_epi64x(key)};
+	std::size_t count{0};
+	std::size_t i{0};
+	for (; i + 4 <= n; i += 4) {
+		__m256i lanes{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i))};
+		unsigned mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(needle, lanes)));
+		count += __builtin_popcount(mask);
+		if (mask != 0xf) {
+			return count;
+		}
+	}
+	return count + count_less_scalar(keys + i, n - i, key);
+}
+
+inline std::size_t count_less_sse2(const std::int32_t *keys, const std::size_t n, const std::int32_t key)
+{
+	const __m128i needle{_mm_set1_epi32(key)};
+	std::size_t count{0};
+	std::size_t i{0};
+	for (; i + 4 <= n; i += 4) {
+		__m128i lanes{_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i))};
+		unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(lanes, needle)));
+		count += __builtin_popcount(mask);
+		if (mask != 0xf) {
+			return count;
+		}
+	}
+	return count + count_less_scalar(keys + i, n - i, key);
+}
+#endif // DM803_SIMD_X86
+
+inline std::size_t count_less(const std::int32_t *keys, const std::size_t n, const std::int32_t key)
+{
+#ifdef DM803_SIMD_X86
+	return HAS_AVX2 ? count_less_avx2(keys, n, key) : count_less_sse2(keys, n, key);
+#else
+	return count_less_scalar(keys, n, key);
+#endif
+}
+
+inline std::size_t count_less(const std::int64_t *keys, const std::size_t n, const std::int64_t key)
+{
+#ifdef DM803_SIMD_X86
+	// SSE2 has no 64 bit comparison, so without AVX2 the scalar count is used
+	return HAS_AVX2 ? count_less_avx2(keys, n, key) : count_less_scalar(keys, n, key);
+#else
+	return count_less_scalar(keys, n, key);
+#endif
+}
+} // namespace simd
+
+/**
+ * @brief Counts the keys of a sorted array that order before the given key, which is the
+ *        position of the first key >= the given key
+ *
+ * @param keys Keys sorted by comp
+ * @param n Number of keys
+ * @param key Key to search for
+ * @param comp Comparator the keys are sorted by
+ * @return std::size_t Number of keys that order before key
+ */
+template<class Key, class Compare>
+inline std::size_t count_less(const Key *keys, const std::size_t n, const Key &key, const Compare &comp)
+{
+	if constexpr (simd::is_vectorizable<Key, Compare>::value) {
+		return simd::count_less(keys, n, key);
+	} else {
+		return std::lower_bound(keys, keys + n, key, comp) - keys;
+	}
+}
+} // namespace DM803
+
+#endif // SIMD_SEARCH_HPP
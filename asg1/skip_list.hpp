@@ -0,0 +1,2923 @@
+/**
+ * @file skip_list.hpp
+ * @brief Header-only implementation of Skip List data structure
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Implementation of Skip List data structure, based on the paper by William Pugh, as an ordered
+ * map from keys of any type to values of any type, with a pluggable comparator and allocator.
+ *
+ * Every forward pointer also stores its width, the number of level 0 steps it spans, as described
+ * in the Skip List cookbook [2]. Counting widths along a search path gives the position of a key,
+ * so ranks and selection by position take expected O(log n) time.
+ *
+ * A node changes level by being replaced with a new node holding the same key and value. Unlike
+ * a std::map, where only erasing an element invalidates it, pointers to values and iterators
+ * into the list may therefore become invalid on operations that leave their key in place. This
+ * happens in three cases:
+ *   - on any insert or delete while nodes are relevelled after set_p(), or after tuning
+ *     changed p, see tune_p();
+ *   - on relevel();
+ *   - while the list is biased, see bias(), on every lookup through a non-const list, i.e.
+ *     search(), get() and find(), which may raise the key found or lower others.
+ * Other pointers and iterators stay valid as in a std::map. The key and value are moved into the
+ * new node if neither move can throw, and otherwise the value is moved and the key copied, which
+ * then has to be copy constructible.
+ *
+ * References:
+ * [1] William Pugh. Skip Lists: A Probabilistic Alternative to Balanced Trees.
+ *     Communications of the ACM, 33(6):668-676, 1990.
+ * [2] William Pugh. A Skip List Cookbook. Technical report CS-TR-2286.1, University of Maryland,
+ *     1990.
+ */
+#ifndef SKIP_LIST_HPP
+#define SKIP_LIST_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "level_generator.hpp"
+#include "skip_list_index.hpp"
+#include "skip_list_key_prefix.hpp"
+#include "skip_list_node_pool.hpp"
+
+namespace DM803
+{
+template<class Key, class Value, bool Prefixed = false>
+struct alignas(void *) SkipListNode : SkipListNodePrefix<Prefixed>
+{
+	using value_type = std::pair<const Key, Value>;
+
+	/**
+	 * @brief Creates a new Skip List Node object with a tower of exactly level forward pointers
+	 *
+	 * The node and its tower of forward pointers share a single allocation, with the tower laid
+	 * out directly after the key and value, followed by the widths of the forward pointers. The
+	 * value is constructed in place from the arguments. A std::string_view key is copied into
+	 * memory from the pool, which the key of the node then views, so the caller's bytes need not
+	 * outlive the call.
+	 *
+	 * @param pool Pool to take the memory for the node from
+	 * @param level Number of forward pointers
+	 * @param key Key
+	 * @param args Arguments to construct the value from
+	 * @return SkipListNode* Pointer to the new node, to be released with destroy()
+	 */
+	template<class Pool, class K, class... Args>
+	static SkipListNode *create(Pool &pool, const int level, K &&key, Args &&...args)
+	{
+		void *memory = pool.allocate(level);
+		SkipListNode *node = new (memory) SkipListNode(level);
+		if constexpr (std::is_same_v<Key, std::string_view>) {
+			std::string_view bytes(key);
+			char *copy = pool.allocate_bytes(bytes.size());
+			std::copy(bytes.begin(), bytes.end(), copy);
+			try {
+				new (node->storage) value_type(std::piecewise_construct,
+				                               std::forward_as_tuple(copy, bytes.size()),
+				                               std::forward_as_tuple(std::forward<Args>(args)...));
+			} catch (...) {
+				pool.deallocate_bytes(copy, bytes.size());
+				pool.deallocate(memory, level);
+				throw;
+			}
+		} else {
+			try {
+				new (node->storage) value_type(std::piecewise_construct,
+				                               std::forward_as_tuple(std::forward<K>(key)),
+				                               std::forward_as_tuple(std::forward<Args>(args)...));
+			} catch (...) {
+				pool.deallocate(memory, level);
+				throw;
+			}
+		}
+		if constexpr (Prefixed) {
+			node->prefix = SkipListKeyPrefix<Key>::of(node->key());
+		}
+		return node;
+	}
+
+	/**
+	 * @brief Creates a node with a tower of exactly level forward pointers and moves the key and
+	 *        value of another node into it, including the bytes of a std::string_view key. The
+	 *        other node must then be released with destroy_moved(). Only the memory for the node
+	 *        is allocated, so nothing is moved if that throws
+	 *
+	 * @param pool Pool to take the memory for the node from
+	 * @param level Number of forward pointers
+	 * @param from Node to move the key and value from
+	 * @return SkipListNode* Pointer to the new node, to be released with destroy()
+	 */
+	template<class Pool>
+	static SkipListNode *relocate(Pool &pool, const int level, SkipListNode *from)
+	{
+		SkipListNode *node = new (pool.allocate(level)) SkipListNode(level);
+		node->take_pair(from);
+		return node;
+	}
+
+	/**
+	 * @brief Moves the key and value of another node into the unconstructed storage of this one,
+	 *        which needs them to be nothrow move constructible
+	 *
+	 * The key is const in the pair, but it is moved from just before the other pair is destroyed,
+	 * as node handles of the standard containers do.
+	 *
+	 * @param from Node to move the key and value from
+	 */
+	void take_pair(SkipListNode *from) noexcept
+	{
+		static_assert(std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<Value>::value,
+		              "moving pairs between nodes must not throw");
+		new (storage) value_type(std::piecewise_construct,
+		                         std::forward_as_tuple(std::move(const_cast<Key &>(from->key()))),
+		                         std::forward_as_tuple(std::move(from->value())));
+		if constexpr (Prefixed) {
+			this->prefix = from->prefix;
+		}
+	}
+
+	/**
+	 * @brief Creates a sentinel node, which has a tower but never holds a key or value, so no
+	 *        key value is reserved for it
+	 *
+	 * @param pool Pool to take the memory for the node from
+	 * @param level Number of forward pointers
+	 * @return SkipListNode* Pointer to the sentinel, to be released with destroy_sentinel()
+	 */
+	template<class Pool>
+	static SkipListNode *create_sentinel(Pool &pool, const int level)
+	{
+		return new (pool.allocate(level)) SkipListNode(level);
+	}
+
+	/**
+	 * @brief Destroys a Skip List Node object created by create()
+	 *
+	 * @param pool Pool the node was created from
+	 * @param node Node to destroy
+	 */
+	template<class Pool>
+	static void destroy(Pool &pool, SkipListNode *node)
+	{
+		destroy_pair(pool, node);
+		destroy_sentinel(pool, node);
+	}
+
+	/**
+	 * @brief Destroys the key and value of a node, and releases the bytes of a std::string_view
+	 *        key, leaving the memory of the node itself to the caller
+	 *
+	 * @param pool Pool the node was created from
+	 * @param node Node whose key and value to destroy
+	 */
+	template<class Pool>
+	static void destroy_pair(Pool &pool, SkipListNode *node)
+	{
+		if constexpr (std::is_same_v<Key, std::string_view>) {
+			pool.deallocate_bytes(const_cast<char *>(node->key().data()), node->key().size());
+		}
+		node->pair().~value_type();
+	}
+
+	/**
+	 * @brief Destroys a node whose key and value were moved to another node with relocate() or
+	 *        take_pair(), leaving the bytes of a std::string_view key to that node
+	 *
+	 * @param pool Pool the node was created from
+	 * @param node Node to destroy
+	 */
+	template<class Pool>
+	static void destroy_moved(Pool &pool, SkipListNode *node)
+	{
+		node->pair().~value_type();
+		destroy_sentinel(pool, node);
+	}
+
+	template<class Pool>
+	static void destroy_sentinel(Pool &pool, SkipListNode *node)
+	{
+		int level{node->level};
+		node->~SkipListNode();
+		pool.deallocate(node, level);
+	}
+
+	/**
+	 * @brief Returns the tower of forward pointers stored after the node
+	 *
+	 * @return SkipListNode** Array of level forward pointers
+	 */
+	SkipListNode **forward()
+	{
+		return reinterpret_cast<SkipListNode **>(this + 1);
+	}
+
+	SkipListNode *const *forward() const
+	{
+		return reinterpret_cast<SkipListNode *const *>(this + 1);
+	}
+
+	/**
+	 * @brief Returns the widths of the forward pointers, stored after the tower. The width of a
+	 *        forward pointer is the number of level 0 steps it spans
+	 *
+	 * @return size_t* Array of level widths
+	 */
+	size_t *width()
+	{
+		return reinterpret_cast<size_t *>(forward() + level);
+	}
+
+	const size_t *width() const
+	{
+		return reinterpret_cast<const size_t *>(forward() + level);
+	}
+
+	/**
+	 * @brief Returns the backward pointer to the previous node at level 0, stored after the
+	 *        widths. Only nodes from a pool sized for it have one
+	 *
+	 * @return SkipListNode*& Backward pointer
+	 */
+	SkipListNode *&backward()
+	{
+		return *reinterpret_cast<SkipListNode **>(width() + level);
+	}
+
+	SkipListNode *backward() const
+	{
+		return *reinterpret_cast<SkipListNode *const *>(width() + level);
+	}
+
+	value_type &pair()
+	{
+		return *std::launder(reinterpret_cast<value_type *>(storage));
+	}
+
+	const value_type &pair() const
+	{
+		return *std::launder(reinterpret_cast<const value_type *>(storage));
+	}
+
+	const Key &key() const
+	{
+		return pair().first;
+	}
+
+	Value &value()
+	{
+		return pair().second;
+	}
+
+	const Value &value() const
+	{
+		return pair().second;
+	}
+
+	// Number of forward pointers
+	int level{};
+
+	// Accesses of the node counted while the list is biased, halved every epoch since the epoch
+	// it was last updated in, and the level drawn for it, which it falls back to when the
+	// accesses decay. These fit into the padding after the level
+	mutable std::uint16_t hits{0};
+	mutable std::uint8_t hit_epoch{0};
+	std::uint8_t drawn_level{};
+
+	// Key and value, left unconstructed in the sentinel
+	alignas(value_type) unsigned char storage[sizeof(value_type)];
+
+private:
+	explicit SkipListNode(const int level)
+		: level(level),
+		  drawn_level(static_cast<std::uint8_t>(level))
+	{
+		std::uninitialized_fill_n(forward(), level, nullptr);
+		std::uninitialized_fill_n(width(), level, 0);
+	}
+};
+
+/**
+ * Enum to choose how bulk loading assigns levels to nodes, where
+ *   - random draws the level of each node as insert does, and
+ *   - ideal gives every (1/p)th node at level i a level above i, for a perfectly balanced list
+ */
+enum class BulkLoadLevels {random, ideal};
+
+template<class Key, class Value, class Compare = std::less<Key>,
+         class Allocator = std::allocator<std::pair<const Key, Value>>, bool BackLinks = false,
+         bool Duplicates = false>
+class SkipList
+{
+	// Whether nodes store the prefix of their key, compared before the key itself
+	static constexpr bool PREFIXED{prefixed_keys_v<Key, Compare>};
+
+	// Whether a node given a new level gets the key and value moved over instead of copying the
+	// key, which needs moves that cannot throw to be undone
+	static constexpr bool RELOCATES{std::is_nothrow_move_constructible<Key>::value
+	                                && std::is_nothrow_move_constructible<Value>::value};
+
+	using Node = SkipListNode<Key, Value, PREFIXED>;
+	using NodePool = SkipListNodePool<Allocator>;
+
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using value_type = std::pair<const Key, Value>;
+	using key_compare = Compare;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	// Default upper bound for the number of possible forward pointers
+	static constexpr int LEVEL_CAP{32};
+
+	// Largest accepted level cap, used to size the on-stack update arrays
+	static constexpr int MAX_LEVEL_CAP{64};
+
+	// Size ratio from which set operations finger search the larger list instead of walking it
+	static constexpr size_t FINGER_MERGE_RATIO{16};
+
+	// Default number of searches search_batch() advances in lockstep
+	static constexpr std::size_t BATCH_GROUP{16};
+
+	// Number of operations between two reconsiderations of p while tuning it
+	static constexpr size_t TUNE_INTERVAL{4096};
+
+	// Least number of nodes given a new level before each write while relevelling after a change
+	// of p, and number of writes the relevelling of a larger list is spread over
+	static constexpr size_t RELEVEL_STEP{8};
+	static constexpr size_t RELEVEL_WRITES{4096};
+
+	// Values of p that tuning chooses between
+	static constexpr double TUNED_P[]{0.5, 0.36788, 0.25, 0.125, 0.0625};
+
+	// Largest number of nodes relevelled after one descent
+	static constexpr size_t RELEVEL_WINDOW{64};
+
+	// Number of accesses between two steps of the sweep that lowers keys no longer accessed
+	// often while biased
+	static constexpr size_t BIAS_INTERVAL{64};
+
+	// Default and least number of accesses after which an access counts half while biased
+	static constexpr size_t BIAS_HALF_LIFE{65536};
+
+	// Least number of accesses counted for a key before it is raised while biased, as raising
+	// it costs about as much as a few searches
+	static constexpr unsigned BIAS_MIN_HITS{16};
+
+	// Number of epochs after which the counts of all nodes are decayed at once while biased, so
+	// that none is left behind far enough for the 8 bit epochs to wrap around
+	static constexpr unsigned BIAS_EPOCH_SWEEP{128};
+
+private:
+	/**
+	 * Search path of a traversal, i.e. the last node visited at each level together with its
+	 * position, where the sentinel is at position 0 and the nodes at positions 1 to n
+	 */
+	struct SearchPath
+	{
+		Node *node[MAX_LEVEL_CAP];
+		size_t rank[MAX_LEVEL_CAP];
+	};
+
+public:
+
+	/**
+	 * @brief Constructs a new Skip List object
+	 *
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater
+	 * @param level_cap Upper bound for the number of possible forward pointers
+	 * @param comp Comparator defining the order of the keys
+	 * @param alloc Allocator to obtain node memory from
+	 */
+	explicit SkipList(const double p=0.5, const int level_cap=LEVEL_CAP, const Compare &comp=Compare(),
+	                  const Allocator &alloc=Allocator())
+		: list_size(0),
+		  level_cap(std::max(1, std::min(level_cap, MAX_LEVEL_CAP))),
+		  max_level(1),
+		  p(p),
+		  comp(comp),
+		  node_pool(this->level_cap, sizeof(Node) + (BackLinks ? sizeof(Node *) : 0), sizeof(Node *) + sizeof(size_t),
+		            alignof(Node), alloc),
+		  sentinel(Node::create_sentinel(node_pool, this->level_cap)),
+		  rng(std::random_device{}()),
+		  level_distribution(p, this->level_cap)
+	{
+		sentinel->forward()[0] = sentinel;
+		sentinel->width()[0] = 1;
+		link_backward(sentinel, sentinel);
+	}
+
+	/**
+	 * @brief Constructs a new Skip List object from a range of key-value pairs sorted by key in
+	 *        strictly increasing order. See bulk_load()
+	 *
+	 * @param first Iterator to the first key-value pair
+	 * @param last Iterator past the last key-value pair
+	 * @param levels How to assign levels to the nodes
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater
+	 * @param level_cap Upper bound for the number of possible forward pointers
+	 * @param comp Comparator defining the order of the keys
+	 * @param alloc Allocator to obtain node memory from
+	 */
+	template<class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+	SkipList(InputIt first, InputIt last, const BulkLoadLevels levels=BulkLoadLevels::random,
+	         const double p=0.5, const int level_cap=LEVEL_CAP, const Compare &comp=Compare(),
+	         const Allocator &alloc=Allocator())
+		: SkipList(p, level_cap, comp, alloc)
+	{
+		bulk_load(first, last, levels);
+	}
+
+	/**
+	 * @brief Constructs a new Skip List object from a stream of whitespace separated keys and
+	 *        values, sorted by key in strictly increasing order. See bulk_load()
+	 *
+	 * @param in Stream to read from until the end or the first key or value that fails to parse
+	 * @param levels How to assign levels to the nodes
+	 * @param p Constant between (0,1) defining number of elements that are level i or greater
+	 * @param level_cap Upper bound for the number of possible forward pointers
+	 * @param comp Comparator defining the order of the keys
+	 * @param alloc Allocator to obtain node memory from
+	 */
+	SkipList(std::istream &in, const BulkLoadLevels levels=BulkLoadLevels::random, const double p=0.5,
+	         const int level_cap=LEVEL_CAP, const Compare &comp=Compare(), const Allocator &alloc=Allocator())
+		: SkipList(p, level_cap, comp, alloc)
+	{
+		bulk_load(in, levels);
+	}
+
+	SkipList(const SkipList &) = delete;
+	SkipList &operator=(const SkipList &) = delete;
+
+	/**
+	 * @brief Constructs a Skip List object taking over the elements of another one, which is
+	 *        left empty
+	 *
+	 * @param other List to take the elements from
+	 */
+	SkipList(SkipList &&other)
+		: SkipList(other.p, other.level_cap, other.comp, other.get_allocator())
+	{
+		node_pool.swap(other.node_pool);
+		std::swap(sentinel, other.sentinel);
+		std::swap(list_size, other.list_size);
+		std::swap(max_level, other.max_level);
+		std::swap(relevel_rank, other.relevel_rank);
+		index_enabled = other.index_enabled;
+		tune_p(other.tuning, other.tuning_link_cost);
+		bias(other.biasing, other.bias_half_life);
+		std::swap(bias_rank, other.bias_rank);
+		std::swap(bias_epoch, other.bias_epoch);
+		std::swap(bias_epoch_hits, other.bias_epoch_hits);
+		std::swap(bias_total, other.bias_total);
+		index.invalidate();
+		// Fingers into the other list must not follow its old nodes
+		other.modification_count++;
+		other.index.invalidate();
+	}
+
+	/**
+	 * @brief Destroys the Skip List object
+	 *
+	 * Nodes holding trivially destructible keys and values are not visited, but released in bulk
+	 * together with the slabs of the node pool, as is the sentinel. Nodes with std::string_view
+	 * keys are, since long keys have memory of their own.
+	 */
+	~SkipList()
+	{
+		if constexpr (!std::is_trivially_destructible<value_type>::value || std::is_same_v<Key, std::string_view>) {
+			for (Node *node = sentinel->forward()[0]; node != sentinel; node = node->forward()[0]) {
+				Node::destroy_pair(node_pool, node);
+			}
+		}
+	}
+
+	/**
+	 * @brief Searches the Skip List for the given key
+	 *
+	 * While the list is biased, see bias(), the search counts an access of the key found, and
+	 * unless the list is const may give it a higher level. It then invalidates all pointers to
+	 * values and all iterators obtained before, as nodes may be replaced.
+	 *
+	 * @param search_key Key to find
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was found, false otherwise
+	 */
+	std::pair<int, bool> search(const Key &search_key)
+	{
+		rebalance();
+		Node *node = sentinel;
+		int comparisons{search_node(search_key, node)};
+		promote(node);
+		return std::make_pair(comparisons, node != sentinel);
+	}
+
+	std::pair<int, bool> search(const Key &search_key) const
+	{
+		Node *node = sentinel;
+		int comparisons{search_node(search_key, node)};
+		return std::make_pair(comparisons, node != sentinel);
+	}
+
+	/**
+	 * @brief Looks up the value stored for the given key
+	 *
+	 * While the list is biased, see bias(), the lookup invalidates all pointers to values and all
+	 * iterators obtained before, as in search().
+	 *
+	 * @param search_key Key to find
+	 * @return Value* Pointer to the value, or null if the key is not present
+	 */
+	Value *get(const Key &search_key)
+	{
+		rebalance();
+		Node *node = promote(find_node(search_key));
+		return node != sentinel ? &node->value() : nullptr;
+	}
+
+	const Value *get(const Key &search_key) const
+	{
+		Node *node = find_node(search_key);
+		return node != sentinel ? &node->value() : nullptr;
+	}
+
+	/**
+	 * @brief Looks up the values stored for a batch of keys
+	 *
+	 * A single search is a chain of dependent loads, with at most one cache miss outstanding at a
+	 * time. Here the searches are run in groups of G, advancing every search of a group by one
+	 * step in turn and prefetching the node each one will compare against next, so that the
+	 * misses of up to G searches overlap.
+	 *
+	 * @param search_keys Keys to find
+	 * @param count Number of keys
+	 * @param results Array receiving, for each key, a pointer to its value or null if the key is
+	 *                not present
+	 */
+	template<std::size_t G = BATCH_GROUP>
+	void search_batch(const Key *search_keys, const size_t count, Value **results)
+	{
+		search_batch<G>(search_keys, count, const_cast<const Value **>(results));
+	}
+
+	template<std::size_t G = BATCH_GROUP>
+	void search_batch(const Key *search_keys, const size_t count, const Value **results) const
+	{
+		static_assert(G > 0, "groups must hold at least one search");
+		// Node each search has reached, the node after it it compares against next, and the level
+		// it is on, or -1 once it is done
+		const Node *node[G];
+		const Node *next[G];
+		int level[G];
+		std::uint64_t prefix[G];
+		for (size_t first = 0; first < count; first += G) {
+			const size_t group{std::min(G, count - first)};
+			for (size_t j = 0; j < group; j++) {
+				prefix[j] = key_prefix(search_keys[first + j]);
+				node[j] = sentinel;
+				level[j] = max_level - 1;
+				next[j] = sentinel->forward()[level[j]];
+				__builtin_prefetch(next[j]);
+			}
+			for (size_t active = group; active > 0; ) {
+				for (size_t j = 0; j < group; j++) {
+					if (level[j] < 0) {
+						continue;
+					}
+					const Key &search_key = search_keys[first + j];
+					if (next[j] != sentinel && less(next[j], search_key, prefix[j])) {
+						node[j] = next[j];
+					} else if (level[j] > 0) {
+						level[j]--;
+					} else {
+						bool found{next[j] != sentinel && equal(next[j], search_key, prefix[j])};
+						results[first + j] = found ? &next[j]->value() : nullptr;
+						level[j] = -1;
+						active--;
+						continue;
+					}
+					next[j] = node[j]->forward()[level[j]];
+					__builtin_prefetch(next[j]);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Forward iterator over the key-value pairs of the Skip List in ascending key order, following
+	 * the level 0 forward pointers. Iterators stay valid until the node they point to is deleted
+	 */
+	template<bool Const>
+	class Iterator
+	{
+	public:
+		using iterator_category = std::conditional_t<BackLinks, std::bidirectional_iterator_tag,
+		                                             std::forward_iterator_tag>;
+		using value_type = typename SkipList::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+		using reference = std::conditional_t<Const, const value_type &, value_type &>;
+
+		Iterator() = default;
+
+		// Allows conversion from iterator to const_iterator
+		template<bool C = Const, class = std::enable_if_t<C>>
+		Iterator(const Iterator<false> &other)
+			: node(other.node)
+		{
+		}
+
+		reference operator*() const
+		{
+			return node->pair();
+		}
+
+		pointer operator->() const
+		{
+			return &node->pair();
+		}
+
+		Iterator &operator++()
+		{
+			node = node->forward()[0];
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator previous(*this);
+			node = node->forward()[0];
+			return previous;
+		}
+
+		// Stepping back follows the backward pointers, so is only there if the list keeps them
+		template<bool B = BackLinks, class = std::enable_if_t<B>>
+		Iterator &operator--()
+		{
+			node = node->backward();
+			return *this;
+		}
+
+		template<bool B = BackLinks, class = std::enable_if_t<B>>
+		Iterator operator--(int)
+		{
+			Iterator next(*this);
+			node = node->backward();
+			return next;
+		}
+
+		friend bool operator==(const Iterator &a, const Iterator &b)
+		{
+			return a.node == b.node;
+		}
+
+		friend bool operator!=(const Iterator &a, const Iterator &b)
+		{
+			return a.node != b.node;
+		}
+
+	private:
+		friend class SkipList;
+
+		explicit Iterator(Node *node)
+			: node(node)
+		{
+		}
+
+		Node *node{nullptr};
+	};
+
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	iterator begin()
+	{
+		return iterator(sentinel->forward()[0]);
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(sentinel->forward()[0]);
+	}
+
+	iterator end()
+	{
+		return iterator(sentinel);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(sentinel);
+	}
+
+	// Reverse iteration starts from the backward pointer of the sentinel, which is the last node
+	reverse_iterator rbegin()
+	{
+		static_assert(BackLinks, "reverse iteration needs a Skip List with backward pointers");
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const
+	{
+		static_assert(BackLinks, "reverse iteration needs a Skip List with backward pointers");
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator rend()
+	{
+		static_assert(BackLinks, "reverse iteration needs a Skip List with backward pointers");
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const
+	{
+		static_assert(BackLinks, "reverse iteration needs a Skip List with backward pointers");
+		return const_reverse_iterator(begin());
+	}
+
+	/**
+	 * @brief Finds the key-value pair with the given key
+	 *
+	 * While the list is biased, see bias(), the lookup invalidates all pointers to values and all
+	 * iterators obtained before, as in search().
+	 *
+	 * @param search_key Key to find
+	 * @return iterator Iterator to the pair, or end() if the key is not present
+	 */
+	iterator find(const Key &search_key)
+	{
+		rebalance();
+		return iterator(promote(find_node(search_key)));
+	}
+
+	const_iterator find(const Key &search_key) const
+	{
+		return const_iterator(find_node(search_key));
+	}
+
+	/**
+	 * @brief Finds the first key-value pair with key >= search key
+	 *
+	 * @param search_key Key to search for
+	 * @return iterator Iterator to the pair, or end() if all keys are smaller
+	 */
+	iterator lower_bound(const Key &search_key)
+	{
+		return iterator(lower_bound_node(search_key));
+	}
+
+	const_iterator lower_bound(const Key &search_key) const
+	{
+		return const_iterator(lower_bound_node(search_key));
+	}
+
+	/**
+	 * @brief Finds the first key-value pair with key > search key
+	 *
+	 * @param search_key Key to search for
+	 * @return iterator Iterator to the pair, or end() if no key is larger
+	 */
+	iterator upper_bound(const Key &search_key)
+	{
+		return iterator(upper_bound_node(search_key));
+	}
+
+	const_iterator upper_bound(const Key &search_key) const
+	{
+		return const_iterator(upper_bound_node(search_key));
+	}
+
+	/**
+	 * @brief Finds the last key-value pair with key <= search key
+	 *
+	 * The descent ends at the pair itself, so no second search or step back is needed.
+	 *
+	 * @param search_key Key to search for
+	 * @return iterator Iterator to the pair, or end() if all keys are larger
+	 */
+	iterator floor(const Key &search_key)
+	{
+		const std::uint64_t prefix{key_prefix(search_key)};
+		return iterator(last_node_where(search_key, [&](const Node *node) {
+			return before(node, search_key, prefix, true);
+		}));
+	}
+
+	const_iterator floor(const Key &search_key) const
+	{
+		return const_cast<SkipList *>(this)->floor(search_key);
+	}
+
+	/**
+	 * @brief Finds the first key-value pair with key >= search key. Same as lower_bound()
+	 *
+	 * @param search_key Key to search for
+	 * @return iterator Iterator to the pair, or end() if all keys are smaller
+	 */
+	iterator ceiling(const Key &search_key)
+	{
+		return lower_bound(search_key);
+	}
+
+	const_iterator ceiling(const Key &search_key) const
+	{
+		return lower_bound(search_key);
+	}
+
+	/**
+	 * @brief Finds the last key-value pair with key < search key
+	 *
+	 * @param search_key Key to search for
+	 * @return iterator Iterator to the pair, or end() if no key is smaller
+	 */
+	iterator predecessor(const Key &search_key)
+	{
+		const std::uint64_t prefix{key_prefix(search_key)};
+		return iterator(last_node_where(search_key, [&](const Node *node) { return less(node, search_key, prefix); }));
+	}
+
+	const_iterator predecessor(const Key &search_key) const
+	{
+		return const_cast<SkipList *>(this)->predecessor(search_key);
+	}
+
+	/**
+	 * @brief Finds the first key-value pair with key > search key. Same as upper_bound()
+	 *
+	 * @param search_key Key to search for
+	 * @return iterator Iterator to the pair, or end() if no key is larger
+	 */
+	iterator successor(const Key &search_key)
+	{
+		return upper_bound(search_key);
+	}
+
+	const_iterator successor(const Key &search_key) const
+	{
+		return upper_bound(search_key);
+	}
+
+	/**
+	 * @brief Visits the key-value pairs with keys in [lo, hi] in ascending key order
+	 *
+	 * The first pair is found by a single descent, after which the pairs are streamed along
+	 * level 0 without further searching.
+	 *
+	 * @param lo Smallest key to visit
+	 * @param hi Largest key to visit
+	 * @param visit Callback invoked as visit(key, value)
+	 * @return size_t Number of pairs visited
+	 */
+	template<class Visitor>
+	size_t range_scan(const Key &lo, const Key &hi, Visitor visit)
+	{
+		size_t visited{0};
+		const std::uint64_t hi_prefix{key_prefix(hi)};
+		for (Node *node = lower_bound_node(lo); node != sentinel && before(node, hi, hi_prefix, true);
+		     node = node->forward()[0]) {
+			visit(node->key(), node->value());
+			visited++;
+		}
+		return visited;
+	}
+
+	template<class Visitor>
+	size_t range_scan(const Key &lo, const Key &hi, Visitor visit) const
+	{
+		size_t visited{0};
+		const std::uint64_t hi_prefix{key_prefix(hi)};
+		for (const Node *node = lower_bound_node(lo); node != sentinel && before(node, hi, hi_prefix, true);
+		     node = node->forward()[0]) {
+			visit(node->key(), node->value());
+			visited++;
+		}
+		return visited;
+	}
+
+	/**
+	 * @brief Counts the keys that order before the given key, which for a key in the Skip List is
+	 *        its zero-based position
+	 *
+	 * @param search_key Key to find the rank of
+	 * @return size_t Number of keys < search key
+	 */
+	size_t rank(const Key &search_key) const
+	{
+		const std::uint64_t prefix{key_prefix(search_key)};
+		return count_while([&](const Node *node) { return less(node, search_key, prefix); });
+	}
+
+	/**
+	 * @brief Finds the key-value pair at the given zero-based position in key order
+	 *
+	 * @param position Position of the pair
+	 * @return iterator Iterator to the pair, or end() if position >= size()
+	 */
+	iterator select(const size_t position)
+	{
+		return iterator(select_node(position));
+	}
+
+	const_iterator select(const size_t position) const
+	{
+		return const_iterator(select_node(position));
+	}
+
+	/**
+	 * @brief Counts the keys in [lo, hi] without visiting them
+	 *
+	 * @param lo Smallest key to count
+	 * @param hi Largest key to count
+	 * @return size_t Number of keys k with lo <= k <= hi
+	 */
+	size_t count_range(const Key &lo, const Key &hi) const
+	{
+		if (comp(hi, lo)) {
+			return 0;
+		}
+		const std::uint64_t prefix{key_prefix(hi)};
+		return count_while([&](const Node *node) { return before(node, hi, prefix, true); }) - rank(lo);
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Skip List, moving or copying the key and value into
+	 *        the new node
+	 *
+	 * @param search_key Key to insert
+	 * @param new_value Value to insert
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key and value was inserted,
+	 * 									    false otherwise (e.g. key already present)
+	 */
+	template<class K, class V>
+	std::pair<int, bool> insert(K &&search_key, V &&new_value)
+	{
+		return emplace(std::forward<K>(search_key), std::forward<V>(new_value));
+	}
+
+	/**
+	 * @brief Inserts a key with a value constructed in place from the given arguments. Nothing is
+	 *        constructed if the key is already present
+	 *
+	 * @param search_key Key to insert
+	 * @param args Arguments to construct the value from
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key and value was inserted,
+	 * 									    false otherwise (e.g. key already present)
+	 */
+	template<class K, class... Args>
+	std::pair<int, bool> emplace(K &&search_key, Args &&...args)
+	{
+		maintain();
+
+		SearchPath update;
+
+		Node *node = sentinel;
+
+		int comparisons(traverse_list(search_key, node, update, 0, Duplicates));
+		record_operation(comparisons, true);
+
+		return insert_after_traversal(comparisons, node, update, std::forward<K>(search_key),
+		                              std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Inserts a key with a value constructed in place from the given arguments, or finds
+	 *        the key if it is already present, in a single traversal. Nothing is constructed if
+	 *        the key is already present
+	 *
+	 * @param search_key Key to insert
+	 * @param args Arguments to construct the value from
+	 * @return std::pair<iterator, bool> first: iterator to the pair with the key
+	 * 									  second: true if key and value was inserted,
+	 * 									  		  false if the key was already present
+	 */
+	template<class K, class... Args>
+	std::pair<iterator, bool> try_emplace(K &&search_key, Args &&...args)
+	{
+		static_assert(!Duplicates, "a Skip List with duplicate keys always inserts, use emplace()");
+		maintain();
+
+		SearchPath update;
+
+		Node *node = sentinel;
+
+		record_operation(traverse_list(search_key, node, update), true);
+
+		if (node != sentinel && equal(node, search_key)) {
+			return std::make_pair(iterator(node), false);
+		}
+		node = Node::create(node_pool, random_level(), std::forward<K>(search_key), std::forward<Args>(args)...);
+		link_after_traversal(node, update);
+		return std::make_pair(iterator(node), true);
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Skip List, or assigns the value to the key if it is
+	 *        already present, in a single traversal
+	 *
+	 * @param search_key Key to insert or update
+	 * @param new_value Value to insert or assign
+	 * @return std::pair<iterator, bool> first: iterator to the pair with the key
+	 * 									  second: true if key and value was inserted,
+	 * 									  		  false if the value was assigned
+	 */
+	template<class K, class V>
+	std::pair<iterator, bool> insert_or_assign(K &&search_key, V &&new_value)
+	{
+		// try_emplace() leaves the value alone unless it inserts it
+		std::pair<iterator, bool> result(try_emplace(std::forward<K>(search_key), std::forward<V>(new_value)));
+		if (!result.second) {
+			result.first->second = std::forward<V>(new_value);
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Returns the value of the key, inserting the key with a value-initialised value
+	 *        first if it is not present
+	 *
+	 * @param search_key Key to look up
+	 * @return Value& Value of the key
+	 */
+	Value &operator[](const Key &search_key)
+	{
+		return try_emplace(search_key).first->second;
+	}
+
+	Value &operator[](Key &&search_key)
+	{
+		return try_emplace(std::move(search_key)).first->second;
+	}
+
+	/**
+	 * @brief Counts the pairs with the given key, which is at most 1 unless the list keeps
+	 *        duplicate keys
+	 *
+	 * @param search_key Key to count
+	 * @return size_t Number of pairs with the key
+	 */
+	size_t count(const Key &search_key) const
+	{
+		return count_range(search_key, search_key);
+	}
+
+	/**
+	 * @brief Finds the pairs with the given key, in the order they were inserted if the list
+	 *        keeps duplicate keys
+	 *
+	 * @param search_key Key to search for
+	 * @return std::pair<iterator, iterator> first: iterator to the first pair with the key
+	 * 										  second: iterator past the last pair with the key
+	 */
+	std::pair<iterator, iterator> equal_range(const Key &search_key)
+	{
+		return std::make_pair(lower_bound(search_key), upper_bound(search_key));
+	}
+
+	std::pair<const_iterator, const_iterator> equal_range(const Key &search_key) const
+	{
+		return std::make_pair(lower_bound(search_key), upper_bound(search_key));
+	}
+
+	/**
+	 * @brief Deletes the key, if present, from the Skip List. Of several pairs with the key, the
+	 *        one inserted first is deleted
+	 *
+	 * @param search_key Key to be deleted
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was found and deleted, false otherwise
+	 */
+	std::pair<int, bool> remove(const Key &search_key)
+	{
+		maintain();
+
+		SearchPath update;
+
+		Node *node = sentinel;
+
+		int comparisons(traverse_list(search_key, node, update));
+		record_operation(comparisons, true);
+
+		return remove_after_traversal(comparisons, node, update, search_key);
+	}
+
+	/**
+	 * Search finger remembering the search path of the last operation made through it, i.e. the
+	 * last node visited at each level. An operation through a finger starts from this path and
+	 * only climbs as high as the distance to the previous key requires, for an expected O(log d)
+	 * cost where d is the number of keys between the two.
+	 *
+	 * A finger is tied to one list, and falls back to a search from the sentinel whenever the list
+	 * has been modified other than through the finger since it was last used.
+	 */
+	class Finger
+	{
+	public:
+		Finger() = default;
+
+	private:
+		friend class SkipList;
+
+		// Last node visited at each level, with positions
+		SearchPath path;
+
+		// List the path belongs to and its modification count when the path was recorded
+		const SkipList *list{nullptr};
+		size_t version{0};
+	};
+
+	/**
+	 * @brief Searches the Skip List for the given key, starting from a search finger
+	 *
+	 * @param finger Finger to search from, updated to the search path of the key
+	 * @param search_key Key to find
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was found, false otherwise
+	 */
+	std::pair<int, bool> search(Finger &finger, const Key &search_key) const
+	{
+		Node *node = sentinel;
+
+		int comparisons(traverse_list(finger, search_key, node));
+
+		if (node != sentinel) {
+			comparisons++;
+			if (equal(node, search_key)) {
+				return std::make_pair(comparisons, true);
+			}
+		}
+		return std::make_pair(comparisons, false);
+	}
+
+	/**
+	 * @brief Inserts key-value pair into the Skip List, starting from a search finger
+	 *
+	 * @param finger Finger to search from, updated to the search path of the key
+	 * @param search_key Key to insert
+	 * @param new_value Value to insert
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key and value was inserted,
+	 * 									    false otherwise (e.g. key already present)
+	 */
+	template<class K, class V>
+	std::pair<int, bool> insert(Finger &finger, K &&search_key, V &&new_value)
+	{
+		return emplace(finger, std::forward<K>(search_key), std::forward<V>(new_value));
+	}
+
+	/**
+	 * @brief Inserts a key with a value constructed in place, starting from a search finger
+	 *
+	 * @param finger Finger to search from, updated to the search path of the key
+	 * @param search_key Key to insert
+	 * @param args Arguments to construct the value from
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key and value was inserted,
+	 * 									    false otherwise (e.g. key already present)
+	 */
+	template<class K, class... Args>
+	std::pair<int, bool> emplace(Finger &finger, K &&search_key, Args &&...args)
+	{
+		maintain();
+
+		Node *node = sentinel;
+
+		int comparisons(traverse_list(finger, search_key, node, Duplicates));
+
+		const int level_before{max_level};
+		std::pair<int, bool> result(insert_after_traversal(comparisons, node, finger.path,
+		                                                   std::forward<K>(search_key),
+		                                                   std::forward<Args>(args)...));
+		keep_finger(finger, level_before);
+		return result;
+	}
+
+	/**
+	 * @brief Deletes the key, if present, from the Skip List, starting from a search finger
+	 *
+	 * @param finger Finger to search from, updated to the search path of the key
+	 * @param search_key Key to be deleted
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was found and deleted, false otherwise
+	 */
+	std::pair<int, bool> remove(Finger &finger, const Key &search_key)
+	{
+		maintain();
+
+		Node *node = sentinel;
+
+		int comparisons(traverse_list(finger, search_key, node));
+
+		const int level_before{max_level};
+		std::pair<int, bool> result(remove_after_traversal(comparisons, node, finger.path, search_key));
+		keep_finger(finger, level_before);
+		return result;
+	}
+
+	/**
+	 * @brief Loads an empty Skip List from a range of key-value pairs sorted by key in strictly
+	 *        increasing order
+	 *
+	 * Rather than inserting the pairs one at a time, every node is appended to the end of each
+	 * of its levels in a single left-to-right pass, so loading n pairs takes O(n) time. Loading
+	 * stops at the first pair whose key is not larger than the one before it.
+	 *
+	 * @param first Iterator to the first key-value pair, moved from if it is a move iterator
+	 * @param last Iterator past the last key-value pair
+	 * @param levels How to assign levels to the nodes
+	 * @return bool True if all pairs were loaded, false if the list was not empty or the keys
+	 *              were out of order
+	 */
+	template<class InputIt>
+	bool bulk_load(InputIt first, InputIt last, const BulkLoadLevels levels=BulkLoadLevels::random)
+	{
+		if (list_size > 0) {
+			return false;
+		}
+		BulkLoader loader(*this, levels);
+		for (; first != last; ++first) {
+			auto &&element = *first;
+			if (!loader.append(std::get<0>(std::forward<decltype(element)>(element)),
+			                   std::get<1>(std::forward<decltype(element)>(element)))) {
+				loader.finish();
+				return false;
+			}
+		}
+		loader.finish();
+		return true;
+	}
+
+	/**
+	 * @brief Loads an empty Skip List from a stream of whitespace separated keys and values,
+	 *        sorted by key in strictly increasing order, as bulk_load() for a range
+	 *
+	 * @param in Stream to read from until the end or the first key or value that fails to parse
+	 * @param levels How to assign levels to the nodes
+	 * @return bool True if all pairs were loaded, false if the list was not empty or the keys
+	 *              were out of order
+	 */
+	bool bulk_load(std::istream &in, const BulkLoadLevels levels=BulkLoadLevels::random)
+	{
+		if (list_size > 0) {
+			return false;
+		}
+		BulkLoader loader(*this, levels);
+		Key key{};
+		Value value{};
+		while (in >> key >> value) {
+			if (!loader.append(std::move(key), std::move(value))) {
+				loader.finish();
+				return false;
+			}
+		}
+		loader.finish();
+		return true;
+	}
+
+	/**
+	 * @brief Adds the elements of another Skip List whose keys are not in this one, and leaves
+	 *        the other list empty
+	 *
+	 * The nodes of the other list are moved over with their towers rather than copied, and the
+	 * memory they live in is handed over to this list, so nothing is allocated apart from a new
+	 * sentinel for the other list. Keys in both lists keep their value from this list. If one
+	 * list is FINGER_MERGE_RATIO or more times larger than the other, the nodes of the smaller one
+	 * are linked into the larger one, each after a finger search from the one before, in
+	 * O(m log(n/m)) expected time for sizes m < n. Otherwise both lists are merged in one pass
+	 * along level 0 in O(n + m) time, rebuilding the towers from left to right.
+	 *
+	 * @param other List to move the elements from
+	 * @return bool True if the lists were merged, false if their allocators do not compare equal,
+	 *              in which case neither list is changed
+	 */
+	bool union_with(SkipList &other)
+	{
+		static_assert(!Duplicates, "set operations need unique keys");
+		if (&other == this) {
+			return true;
+		}
+		if (!node_pool.shares_allocator(other.node_pool)) {
+			return false;
+		}
+		node_pool.splice(other.node_pool);
+		if (other.list_size * FINGER_MERGE_RATIO <= list_size) {
+			link_all(other, false);
+		} else if (list_size * FINGER_MERGE_RATIO <= other.list_size && level_cap == other.level_cap) {
+			// Link the nodes of this list into the other one, and keep the result. The pending
+			// relevel and the access counts of the other list stay with its towers, so the nodes
+			// of this list are relevelled first and their counts aged by the epoch of the other
+			relevel();
+			for (Node *node = sentinel->forward()[0]; node != sentinel; node = node->forward()[0]) {
+				node->hit_epoch = static_cast<std::uint8_t>(other.bias_epoch - (bias_epoch - node->hit_epoch));
+			}
+			std::swap(sentinel, other.sentinel);
+			std::swap(list_size, other.list_size);
+			std::swap(max_level, other.max_level);
+			std::swap(relevel_rank, other.relevel_rank);
+			std::swap(bias_rank, other.bias_rank);
+			std::swap(bias_epoch, other.bias_epoch);
+			std::swap(bias_epoch_hits, other.bias_epoch_hits);
+			std::swap(bias_total, other.bias_total);
+			bias_total += other.bias_total;
+			if (other.p != p) {
+				// The towers kept were drawn with the p of the other list
+				relevel_rank = 1;
+			}
+			modification_count++;
+			index.invalidate();
+			link_all(other, true);
+		} else {
+			merge_all(other);
+		}
+		other.start_empty(node_pool);
+		return true;
+	}
+
+	/**
+	 * @brief Moves the elements with keys >= the given key to a new Skip List
+	 *
+	 * Only the links crossing the split point and the last link of each level are changed, which
+	 * are found by two descents, so splitting takes O(log n) expected time however many elements
+	 * move. The new list uses the same memory for the nodes as this one, which stays allocated
+	 * until both lists are destroyed.
+	 *
+	 * @param split_key Smallest key to move
+	 * @return SkipList List with the elements with keys >= split key, with the same parameters and
+	 *                  settings as this one
+	 */
+	SkipList split(const Key &split_key)
+	{
+		SkipList upper(p, level_cap, comp, get_allocator());
+		upper.node_pool.share(node_pool);
+		upper.index_enabled = index_enabled;
+		upper.tune_p(tuning, tuning_link_cost);
+		upper.bias(biasing, bias_half_life);
+		// The nodes moved keep the epochs their accesses were counted in
+		upper.bias_epoch = bias_epoch;
+		upper.bias_epoch_hits = bias_epoch_hits;
+		SearchPath update;
+		Node *node = sentinel;
+		traverse_list(split_key, node, update);
+		if (node == sentinel) {
+			return upper;
+		}
+		SearchPath last;
+		find_last(last);
+		size_t lower_size{update.rank[0]};
+		for (size_t i = 0; i < static_cast<size_t>(max_level); i++) {
+			Node *first = update.node[i]->forward()[i];
+			if (first != sentinel) {
+				upper.sentinel->forward()[i] = first;
+				upper.sentinel->width()[i] = update.rank[i] + update.node[i]->width()[i] - lower_size;
+				last.node[i]->forward()[i] = upper.sentinel;
+			} else {
+				upper.sentinel->forward()[i] = upper.sentinel;
+				upper.sentinel->width()[i] = list_size - lower_size + 1;
+			}
+			update.node[i]->forward()[i] = sentinel;
+			update.node[i]->width()[i] = lower_size + 1 - update.rank[i];
+		}
+		link_backward(upper.sentinel, last.node[0]);
+		link_backward(node, upper.sentinel);
+		link_backward(sentinel, update.node[0]);
+		upper.list_size = list_size - lower_size;
+		upper.max_level = max_level;
+		upper.lower_max_level();
+		// The accesses counted are shared out in proportion to the number of nodes
+		upper.bias_total = bias_total * upper.list_size / list_size;
+		bias_total -= upper.bias_total;
+		// The nodes left to relevel after a change of p stay left in the list they move to
+		if (relevel_rank > lower_size) {
+			upper.relevel_rank = relevel_rank - lower_size;
+			relevel_rank = 0;
+		} else if (relevel_rank > 0) {
+			upper.relevel_rank = 1;
+		}
+		list_size = lower_size;
+		modification_count++;
+		index.invalidate();
+		lower_max_level();
+		return upper;
+	}
+
+	/**
+	 * @brief Appends the elements of another Skip List whose keys are all larger than the keys
+	 *        of this one, and leaves the other list empty
+	 *
+	 * Only the last link of each level of this list and of the other list are changed, which are
+	 * found by one descent in each, so concatenating takes O(log n + log m) expected time for
+	 * sizes n and m. If the lists use different numbers of levels, the one using fewer first
+	 * links its next level, which only visits the few nodes in its top level. The memory of the
+	 * nodes of the other list is handed over to this list, and only a new sentinel for the other
+	 * list is allocated. Nodes of the other list still to be relevelled after a change of p, or
+	 * all of them if it uses another p, are relevelled as part of this list.
+	 *
+	 * @param other List to take the elements from
+	 * @return bool True if the lists were concatenated, false if the keys of the lists overlap or
+	 *              their allocators do not compare equal, in which case neither list is changed
+	 */
+	bool concat(SkipList &other)
+	{
+		if (&other == this || other.list_size == 0) {
+			return &other != this || list_size == 0;
+		}
+		if (!node_pool.shares_allocator(other.node_pool)) {
+			return false;
+		}
+		SearchPath last;
+		find_last(last);
+		const Key &first_key = other.sentinel->forward()[0]->key();
+		if (list_size > 0 && (Duplicates ? comp(first_key, last.node[0]->key()) : !comp(last.node[0]->key(), first_key))) {
+			return false;
+		}
+		while (max_level < std::min(other.max_level, level_cap)) {
+			increase_max_level_of_list();
+		}
+		while (other.max_level < std::min(max_level, other.level_cap)) {
+			other.increase_max_level_of_list();
+		}
+		find_last(last);
+		SearchPath other_last;
+		other.find_last(other_last);
+		node_pool.splice(other.node_pool);
+		link_backward(other.sentinel->forward()[0], last.node[0]);
+		link_backward(sentinel, other_last.node[0]);
+		for (size_t i = 0; i < static_cast<size_t>(max_level); i++) {
+			if (i < static_cast<size_t>(other.max_level) && other.sentinel->forward()[i] != other.sentinel) {
+				last.node[i]->forward()[i] = other.sentinel->forward()[i];
+				last.node[i]->width()[i] = list_size + other.sentinel->width()[i] - last.rank[i];
+				other_last.node[i]->forward()[i] = sentinel;
+			} else {
+				last.node[i]->width()[i] += other.list_size;
+			}
+		}
+		// The nodes left to relevel in the other list stay left, after those left in this one
+		size_t other_relevel_rank{other.p != p ? 1 : other.relevel_rank};
+		if (relevel_rank == 0 && other_relevel_rank > 0) {
+			relevel_rank = list_size + other_relevel_rank;
+		}
+		list_size += other.list_size;
+		modification_count++;
+		index.invalidate();
+		while (static_cast <int> (std::floor(L(list_size))) > max_level && max_level < level_cap) {
+			increase_max_level_of_list();
+		}
+		other.start_empty(node_pool);
+		return true;
+	}
+
+	/**
+	 * @brief Removes the elements whose keys are not in another Skip List
+	 *
+	 * Makes one pass along level 0 of this list, relinking the nodes that are kept and
+	 * rebuilding their towers from left to right. The keys are looked up in the other list by
+	 * walking along its level 0 in step, in O(n + m) time for sizes n and m, or, if the other
+	 * list is FINGER_MERGE_RATIO or more times larger, by finger searches from the key before,
+	 * in O(n log(m/n)) expected time.
+	 *
+	 * @param other List holding the keys to keep
+	 */
+	void intersect_with(const SkipList &other)
+	{
+		static_assert(!Duplicates, "set operations need unique keys");
+		if (&other != this) {
+			retain(other, true);
+		}
+	}
+
+	/**
+	 * @brief Removes the elements whose keys are in another Skip List
+	 *
+	 * If this list is FINGER_MERGE_RATIO or more times larger than the other one, the keys of the
+	 * other list are removed one at a time, each after a finger search from the one before, in
+	 * O(m log(n/m)) expected time for sizes n and m. Otherwise this is done as intersect_with(),
+	 * keeping the nodes that are not found instead.
+	 *
+	 * @param other List holding the keys to remove
+	 */
+	void difference_with(const SkipList &other)
+	{
+		static_assert(!Duplicates, "set operations need unique keys");
+		if (&other == this) {
+			clear();
+		} else if (other.list_size * FINGER_MERGE_RATIO <= list_size) {
+			Finger finger;
+			for (const Node *removing = other.sentinel->forward()[0]; removing != other.sentinel;
+			     removing = removing->forward()[0]) {
+				int level_before{max_level};
+				Node *node = sentinel;
+				int comparisons(traverse_list(finger, removing->key(), node));
+				remove_after_traversal(comparisons, node, finger.path, removing->key());
+				keep_finger(finger, level_before);
+			}
+		} else {
+			retain(other, false);
+		}
+	}
+
+	/**
+	 * @brief Removes all elements from the Skip List
+	 *
+	 */
+	void clear()
+	{
+		for (Node *node = sentinel->forward()[0]; node != sentinel; ) {
+			Node *next = node->forward()[0];
+			Node::destroy(node_pool, node);
+			node = next;
+		}
+		list_size = 0;
+		relevel_rank = 0;
+		BulkLoader(*this, BulkLoadLevels::random).finish();
+	}
+
+	/**
+	 * @brief Turns the express-lane index over the upper levels on or off
+	 *
+	 * With the index on, search(), find(), get(), lower_bound(), upper_bound() and range_scan()
+	 * start from a copy of levels 1 and up packed into flat arrays (see skip_list_index.hpp), and
+	 * only finish the search in the linked list. The number of comparisons search() returns then
+	 * leaves out those made in the flat arrays. The index is kept correct on every write and
+	 * rebuilt by the first read after enough writes have accumulated, which suits read-mostly
+	 * workloads. Since reads may rebuild the index, a list with the index on must not be read by
+	 * several threads at once.
+	 *
+	 * @param enabled True to use the index
+	 */
+	void use_index(const bool enabled)
+	{
+		static_assert(std::is_copy_constructible<Key>::value, "the index copies the keys");
+		index_enabled = enabled;
+		index.invalidate();
+	}
+
+	bool uses_index() const
+	{
+		return index_enabled;
+	}
+
+	/**
+	 * @brief Turns tuning of p to the workload on or off
+	 *
+	 * While tuning, searches, inserts and deletes not made through a finger count their
+	 * comparisons, as those through a finger depend on the distance to the last key, and every
+	 * TUNE_INTERVAL operations the next write compares the expected cost per operation of each
+	 * value in TUNED_P. The cost of a value q is the search cost L(n)/q + 1/(1-q) of Pugh, scaled
+	 * by how the comparisons counted compare to it for the current p, plus 1/(1-q) forward
+	 * pointers per node, weighted by the share of writes and by link cost. If another value is
+	 * more than 5% cheaper, the list switches to it with set_p().
+	 *
+	 * @param enabled True to tune p
+	 * @param link_cost Cost of one forward pointer per node, in comparisons per operation, where
+	 *                  larger values trade search time for memory
+	 */
+	void tune_p(const bool enabled, const double link_cost=1.0)
+	{
+		tuning = enabled;
+		tuning_link_cost = link_cost;
+		tuned_operations = 0;
+		tuned_writes = 0;
+		tuned_comparisons = 0;
+	}
+
+	bool tunes_p() const
+	{
+		return tuning;
+	}
+
+	double get_p() const
+	{
+		return p;
+	}
+
+	/**
+	 * @brief Changes p, and with it the level of new nodes and the number of levels in use
+	 *
+	 * The existing nodes are given new levels drawn with the new p a few at a time before every
+	 * insert or delete, enough to be done after RELEVEL_WRITES of them, or all at once by calling
+	 * relevel(), e.g. when the list is idle. Until then, searches still take expected O(log n)
+	 * time, with constants between those of the old and the new p.
+	 *
+	 * @param new_p Constant between (0,1) defining number of elements that are level i or greater
+	 */
+	void set_p(const double new_p)
+	{
+		p = new_p;
+		level_distribution = GeometricLevels(p, level_cap);
+		relevel_rank = list_size > 0 ? 1 : 0;
+		lower_max_level();
+	}
+
+	/**
+	 * @brief Gives nodes left over from a change of p a new level, from left to right
+	 *
+	 * Every window of nodes is found by a descent by position, after which the towers in it are
+	 * rebuilt and the links crossing its ends are joined up, just as increase_max_level_of_list()
+	 * links a new level. A node whose level changes is replaced by a new node with the same key
+	 * and value, so iterators to it become invalid. Inserts and deletes in between only shift
+	 * which nodes are left, which does no harm as the levels are random anyway.
+	 *
+	 * @param nodes Largest number of nodes to give a new level
+	 * @return size_t Number of nodes still left
+	 */
+	size_t relevel(size_t nodes=std::numeric_limits<size_t>::max())
+	{
+		while (nodes > 0 && relevel_rank > 0 && relevel_rank <= list_size) {
+			size_t count{std::min(std::min(nodes, RELEVEL_WINDOW), list_size - relevel_rank + 1)};
+			relevel_window(relevel_rank, count);
+			relevel_rank += count;
+			nodes -= count;
+		}
+		if (relevel_rank > list_size) {
+			relevel_rank = 0;
+			while (list_size > 0 && static_cast <int> (std::floor(L(list_size))) > max_level && max_level < level_cap) {
+				increase_max_level_of_list();
+			}
+			lower_max_level();
+		}
+		return relevel_rank > 0 ? list_size - relevel_rank + 1 : 0;
+	}
+
+	/**
+	 * @brief Turns biasing of the levels towards frequently accessed keys on or off
+	 *
+	 * While biased, search(), get() and find() count the accesses of every key found, halving the
+	 * counts every half life, so that a key accessed a fraction f of the time has about
+	 * 2 * f * half life accesses. A key that is accessed at least (1/p)^i times as often as the
+	 * average key, f * n >= (1/p)^i, is given at least level i + 1 when it is found, which at
+	 * most n * p^i keys can be, as many as random levels give. It is found after about
+	 * log_{1/p}(1/f) / p comparisons instead of L(n) / p, so a skewed workload comes close to the
+	 * entropy bound. Every BIAS_INTERVAL accesses, the next few nodes are visited to lower the
+	 * keys whose counts have decayed back to the level drawn for them, sweeping the whole list
+	 * once every half life. Raising or lowering a node replaces it, as relevel() does, so while
+	 * biased, every lookup through a non-const list invalidates the pointers to values and the
+	 * iterators returned by earlier ones, also for other keys. Lookups through a const reference
+	 * to the list leave them valid.
+	 *
+	 * Levels are only changed through non-const lists, as a const list only counts accesses.
+	 * Turning biasing off leaves the levels as they are until set_p() relevels the list.
+	 *
+	 * @param enabled True to bias the levels
+	 * @param half_life Number of accesses after which an access counts half, raised to the size
+	 *                  of the list if smaller
+	 */
+	void bias(const bool enabled, const size_t half_life=BIAS_HALF_LIFE)
+	{
+		biasing = enabled;
+		bias_half_life = std::max<size_t>(1, half_life);
+		bias_accesses = 0;
+	}
+
+	bool biased() const
+	{
+		return biasing;
+	}
+
+	/**
+	 * @brief Returns the number of elements in the Skip List
+	 *
+	 * @return size_t
+	 */
+	size_t size() const
+	{
+		return list_size;
+	}
+
+	bool empty() const
+	{
+		return list_size == 0;
+	}
+
+	key_compare key_comp() const
+	{
+		return comp;
+	}
+
+	allocator_type get_allocator() const
+	{
+		return node_pool.get_allocator();
+	}
+
+	/**
+	 * @brief Allows printing of the keys of the Skip List
+	 *
+	 * @param s Reference to output stream
+	 * @param l Skip List to print
+	 * @return std::ostream& Reference to output stream
+	 */
+	friend std::ostream &operator<<(std::ostream &s, const SkipList &l)
+	{
+		const Node *node = l.sentinel->forward()[0];
+		for (size_t i = 0; i < l.size(); i++) {
+			if (i > 0) {
+				s << "->";
+			}
+			s << "[" << node->key() << "]";
+			node = node->forward()[0];
+		}
+		return s;
+	}
+
+private:
+	/**
+	 * Appends nodes in increasing key order to the end of every level of an empty Skip List,
+	 * keeping track of the last node at each level
+	 */
+	class BulkLoader
+	{
+	public:
+		BulkLoader(SkipList &list, const BulkLoadLevels levels)
+			: list(list),
+			  levels(levels),
+			  branching(std::max(2L, std::lround(1.0 / list.p)))
+		{
+			std::fill_n(last, list.level_cap, list.sentinel);
+			std::fill_n(last_rank, list.level_cap, 0);
+		}
+
+		/**
+		 * @brief Appends a key-value pair after the last node
+		 *
+		 * @param key Key, which must be larger than the key of the last node, or not smaller if
+		 *            the list keeps duplicate keys
+		 * @param value Value
+		 * @return bool True if the pair was appended, false if the key was out of order
+		 */
+		template<class K, class V>
+		bool append(K &&key, V &&value)
+		{
+			if (last[0] != list.sentinel
+			    && (Duplicates ? list.comp(key, last[0]->key()) : !list.comp(last[0]->key(), key))) {
+				return false;
+			}
+			relink(Node::create(list.node_pool, next_level(), std::forward<K>(key), std::forward<V>(value)));
+			return true;
+		}
+
+		/**
+		 * @brief Appends an existing node after the last node, keeping its tower
+		 *
+		 * @param node Node with a key larger than the key of the last node, whose links are
+		 *             overwritten, which may come from a list with a larger level cap
+		 */
+		void relink(Node *node)
+		{
+			link_backward(node, last[0]);
+			list.list_size++;
+			for (size_t i = 0; i < static_cast<size_t>(std::min(node->level, list.level_cap)); i++) {
+				last[i]->forward()[i] = node;
+				last[i]->width()[i] = list.list_size - last_rank[i];
+				last[i] = node;
+				last_rank[i] = list.list_size;
+			}
+		}
+
+		/**
+		 * @brief Terminates every level at the sentinel and sets the number of levels in use to
+		 *        what inserting the same number of keys one at a time would arrive at, or to 1 if
+		 *        there are none
+		 *
+		 */
+		void finish()
+		{
+			for (size_t i = 0; i < static_cast<size_t>(list.level_cap); i++) {
+				last[i]->forward()[i] = list.sentinel;
+				last[i]->width()[i] = list.list_size + 1 - last_rank[i];
+			}
+			link_backward(list.sentinel, last[0]);
+			// A list left empty, e.g. by clear(), goes back to the single level of a new list
+			list.max_level = 1;
+			if (list.list_size > 0) {
+				list.max_level = std::max(1, std::min(list.level_cap, static_cast<int>(std::floor(list.L(list.list_size)))));
+			}
+			list.modification_count++;
+			list.index.invalidate();
+		}
+
+	private:
+		/**
+		 * @brief Picks the level of the next node. For ideal levels, the ith node gets one level
+		 *        more for each time 1/p divides i
+		 *
+		 * @return int Positive integer in range [1,level cap]
+		 */
+		int next_level()
+		{
+			if (levels == BulkLoadLevels::random) {
+				return list.random_level();
+			}
+			int level{1};
+			for (size_t i = list.list_size + 1; i % branching == 0 && level < list.level_cap; i /= branching) {
+				level++;
+			}
+			return level;
+		}
+
+		SkipList &list;
+		const BulkLoadLevels levels;
+
+		// Rounded value of 1/p, used for ideal levels
+		const size_t branching;
+
+		// Last node at each level so far, and its position counting from 1
+		Node *last[MAX_LEVEL_CAP];
+		size_t last_rank[MAX_LEVEL_CAP];
+	};
+
+	/**
+	 * @brief Computes the prefix of a search key once, for all the comparisons of a search
+	 *
+	 * @param search_key Key to search for
+	 * @return std::uint64_t Prefix of the key, or 0 if nodes store no prefixes
+	 */
+	std::uint64_t key_prefix(const Key &search_key) const
+	{
+		if constexpr (PREFIXED) {
+			return SkipListKeyPrefix<Key>::of(search_key);
+		} else {
+			return 0;
+		}
+	}
+
+	/**
+	 * @brief Compares the key of a node, which must not be the sentinel, to a search key
+	 *
+	 * @param node Node to compare
+	 * @param search_key Key to compare against
+	 * @param prefix Prefix of the search key, from key_prefix()
+	 * @return bool True if the key of the node orders before the search key
+	 */
+	bool less(const Node *node, const Key &search_key, const std::uint64_t prefix) const
+	{
+		if constexpr (PREFIXED) {
+			if (node->prefix != prefix) {
+				return node->prefix < prefix;
+			}
+		}
+		return comp(node->key(), search_key);
+	}
+
+	/**
+	 * @brief Compares the key of a node, which must not be the sentinel, to a search key, for a
+	 *        traversal that stops either before or after the keys equal to it
+	 *
+	 * @param node Node to compare
+	 * @param search_key Key to compare against
+	 * @param prefix Prefix of the search key, from key_prefix()
+	 * @param past_equal True to also pass nodes with keys equal to the search key
+	 * @return bool True if the traversal should move past the node
+	 */
+	bool before(const Node *node, const Key &search_key, const std::uint64_t prefix, const bool past_equal) const
+	{
+		if constexpr (PREFIXED) {
+			if (node->prefix != prefix) {
+				return node->prefix < prefix;
+			}
+		}
+		return past_equal ? !comp(search_key, node->key()) : comp(node->key(), search_key);
+	}
+
+	/**
+	 * @brief Checks if the key of a node, known not to order before the search key, equals it
+	 *
+	 * @param node Node to compare
+	 * @param search_key Key to compare against
+	 * @param prefix Prefix of the search key, from key_prefix()
+	 * @return bool True if the key of the node is equivalent to the search key
+	 */
+	bool equal(const Node *node, const Key &search_key, const std::uint64_t prefix) const
+	{
+		if constexpr (PREFIXED) {
+			if (node->prefix != prefix) {
+				return false;
+			}
+		}
+		return !comp(search_key, node->key());
+	}
+
+	bool equal(const Node *node, const Key &search_key) const
+	{
+		return equal(node, search_key, key_prefix(search_key));
+	}
+
+	/**
+	 * @brief Finds the last node at each level in use
+	 *
+	 * @param last Receives the last node at each level and its position
+	 */
+	void find_last(SearchPath &last) const
+	{
+		Node *node = sentinel;
+		size_t rank{0};
+		for (size_t i = max_level; i > 0; i--) {
+			while (node->forward()[i-1] != sentinel) {
+				rank += node->width()[i-1];
+				node = node->forward()[i-1];
+			}
+			last.node[i-1] = node;
+			last.rank[i-1] = rank;
+		}
+	}
+
+	/**
+	 * @brief Stops using the empty top levels after elements were split off, as long as the
+	 *        number of levels stays at least what removing them one at a time would leave
+	 *
+	 */
+	void lower_max_level()
+	{
+		while (max_level > 1 && sentinel->forward()[max_level-1] == sentinel
+		       && (list_size == 0 || static_cast <int> (std::ceil(L(list_size))) < max_level)) {
+			max_level--;
+		}
+	}
+
+	/**
+	 * @brief Starts over with a new sentinel and no elements after all nodes were moved to another
+	 *        list, together with the memory of the old sentinel
+	 *
+	 * @param receiver Pool of the list the nodes were moved to
+	 */
+	void start_empty(NodePool &receiver)
+	{
+		Node *old_sentinel = sentinel;
+		sentinel = Node::create_sentinel(node_pool, level_cap);
+		sentinel->forward()[0] = sentinel;
+		sentinel->width()[0] = 1;
+		link_backward(sentinel, sentinel);
+		Node::destroy_sentinel(receiver, old_sentinel);
+		list_size = 0;
+		max_level = 1;
+		relevel_rank = 0;
+		modification_count++;
+		index.invalidate();
+	}
+
+	/**
+	 * @brief Links every node of another list, whose memory this list already owns, into this
+	 *        one, finger searching for each from the one before, and leaves the other list
+	 *        without nodes but otherwise untouched
+	 *
+	 * @param other List to take the nodes from
+	 * @param keep_values_of_other True to keep the value from the other list for keys in both
+	 */
+	void link_all(SkipList &other, const bool keep_values_of_other)
+	{
+		Finger finger;
+		for (Node *incoming = other.sentinel->forward()[0]; incoming != other.sentinel; ) {
+			Node *next = incoming->forward()[0];
+			int level_before{max_level};
+			Node *node = sentinel;
+			traverse_list(finger, incoming->key(), node);
+			if (node != sentinel && equal(node, incoming->key())) {
+				if (keep_values_of_other) {
+					std::swap(node->value(), incoming->value());
+				}
+				Node::destroy(node_pool, incoming);
+			} else {
+				link_after_traversal(incoming, finger.path);
+			}
+			keep_finger(finger, level_before);
+			incoming = next;
+		}
+	}
+
+	/**
+	 * @brief Merges the nodes of another list, whose memory this list already owns, with the
+	 *        nodes of this one in a single pass, and leaves the other list without nodes but
+	 *        otherwise untouched. Keys in both keep the node of this list
+	 *
+	 * @param other List to take the nodes from
+	 */
+	void merge_all(SkipList &other)
+	{
+		Node *mine = sentinel->forward()[0];
+		Node *theirs = other.sentinel->forward()[0];
+		list_size = 0;
+		BulkLoader loader(*this, BulkLoadLevels::random);
+		while (mine != sentinel || theirs != other.sentinel) {
+			bool take_mine{theirs == other.sentinel || (mine != sentinel && !comp(theirs->key(), mine->key()))};
+			bool take_theirs{mine == sentinel || (theirs != other.sentinel && !comp(mine->key(), theirs->key()))};
+			// The next node is read before the node is relinked, which overwrites its links
+			if (take_mine) {
+				Node *next = mine->forward()[0];
+				loader.relink(mine);
+				mine = next;
+			}
+			if (take_theirs) {
+				Node *next = theirs->forward()[0];
+				if (take_mine) {
+					Node::destroy(node_pool, theirs);
+				} else {
+					loader.relink(theirs);
+				}
+				theirs = next;
+			}
+		}
+		loader.finish();
+	}
+
+	/**
+	 * @brief Keeps the nodes whose keys are, or are not, in another list, in a single pass that
+	 *        relinks the nodes kept and destroys the others
+	 *
+	 * @param other List to look the keys up in
+	 * @param keep_found True to keep the nodes whose keys are found, false to keep the others
+	 */
+	void retain(const SkipList &other, const bool keep_found)
+	{
+		bool finger_search{list_size * FINGER_MERGE_RATIO <= other.list_size};
+		Finger finger;
+		Node *theirs = other.sentinel->forward()[0];
+		Node *mine = sentinel->forward()[0];
+		list_size = 0;
+		BulkLoader loader(*this, BulkLoadLevels::random);
+		while (mine != sentinel) {
+			Node *next = mine->forward()[0];
+			if (finger_search) {
+				other.traverse_list(finger, mine->key(), theirs);
+			} else {
+				while (theirs != other.sentinel && comp(theirs->key(), mine->key())) {
+					theirs = theirs->forward()[0];
+				}
+			}
+			bool found{theirs != other.sentinel && !comp(mine->key(), theirs->key())};
+			if (found == keep_found) {
+				loader.relink(mine);
+			} else {
+				Node::destroy(node_pool, mine);
+			}
+			mine = next;
+		}
+		loader.finish();
+		if (list_size == 0) {
+			relevel_rank = 0;
+		}
+	}
+
+	/**
+	 * @brief Links a new node in after a traversal that did not find the search key
+	 *
+	 * @param comparisons Number of comparisons made during traversal
+	 * @param node First node with key >= search key, as left by the traversal
+	 * @param update Update array filled in by the traversal
+	 * @param search_key Key to insert
+	 * @param args Arguments to construct the value from
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key and value was inserted,
+	 * 									    false otherwise (e.g. key already present)
+	 */
+	template<class K, class... Args>
+	std::pair<int, bool> insert_after_traversal(int comparisons, Node *node, SearchPath &update,
+	                                            K &&search_key, Args &&...args)
+	{
+		// With duplicate keys the traversal has passed the equal keys, so the key goes after them
+		if (!Duplicates && node != sentinel) {
+			comparisons++;
+			if (equal(node, search_key)) {
+				return std::make_pair(comparisons, false);
+			}
+		}
+		link_after_traversal(Node::create(node_pool, random_level(), std::forward<K>(search_key),
+		                                  std::forward<Args>(args)...), update);
+		return std::make_pair(comparisons, true);
+	}
+
+	/**
+	 * @brief Points the backward pointer of a node at the node before it at level 0, if the list
+	 *        keeps backward pointers, otherwise does nothing
+	 *
+	 * @param node Node, or the sentinel to set the last node
+	 * @param previous Node before it at level 0, or the sentinel if it is the first node
+	 */
+	static void link_backward(Node *node, Node *previous)
+	{
+		if constexpr (BackLinks) {
+			node->backward() = previous;
+		}
+	}
+
+	/**
+	 * @brief Links a node into the Skip List at the position found by a traversal
+	 *
+	 * @param node Node to link, with a key not in the list, which may come from a list with a
+	 *             larger level cap
+	 * @param update Search path of the key of the node
+	 */
+	void link_after_traversal(Node *node, SearchPath &update)
+	{
+		// Links spanning the new position grow by one, and those of the new node split them
+		size_t rank{update.rank[0] + 1};
+		for (size_t i = 0; i < static_cast<size_t>(max_level); i++) {
+			Node *previous = update.node[i];
+			if (i < static_cast<size_t>(node->level)) {
+				node->forward()[i] = previous->forward()[i];
+				node->width()[i] = previous->width()[i] + update.rank[i] + 1 - rank;
+				previous->forward()[i] = node;
+				previous->width()[i] = rank - update.rank[i];
+			} else {
+				previous->width()[i]++;
+			}
+		}
+		link_backward(node, update.node[0]);
+		link_backward(node->forward()[0], node);
+		list_size++;
+		modification_count++;
+		if (index_enabled) {
+			index.record_write();
+		}
+		if (static_cast <int> (std::floor(L(list_size))) > max_level && max_level < level_cap) {
+			increase_max_level_of_list();
+		}
+	}
+
+	/**
+	 * @brief Unlinks and destroys the node found by a traversal, if it holds the search key
+	 *
+	 * @param comparisons Number of comparisons made during traversal
+	 * @param node First node with key >= search key, as left by the traversal
+	 * @param update Update array filled in by the traversal
+	 * @param search_key Key to be deleted
+	 * @return std::pair<int, bool> first: number of comparisons
+	 * 								second: true if key was found and deleted, false otherwise
+	 */
+	std::pair<int, bool> remove_after_traversal(int comparisons, Node *node, SearchPath &update,
+	                                            const Key &search_key)
+	{
+		if (node != sentinel) {
+			comparisons++;
+			if (equal(node, search_key)) {
+				for (size_t i = 0; i < static_cast<size_t>(max_level); i++) {
+					Node *previous = update.node[i];
+					if (i < static_cast<size_t>(node->level)) {
+						previous->forward()[i] = node->forward()[i];
+						previous->width()[i] += node->width()[i] - 1;
+					} else {
+						previous->width()[i]--;
+					}
+				}
+				link_backward(node->forward()[0], update.node[0]);
+				list_size--;
+				modification_count++;
+				if (index_enabled) {
+					index.remove(node, comp);
+					index.record_write();
+				}
+				Node::destroy(node_pool, node);
+				if (list_size == 0) {
+					// Nothing is left to relevel
+					relevel_rank = 0;
+				} else if (static_cast <int> (std::ceil(L(list_size))) < max_level) {
+					if (max_level > 1) {
+						max_level--;
+					}
+				}
+				return std::make_pair(comparisons, true);
+			}
+		}
+		return std::make_pair(comparisons, false);
+	}
+
+	/**
+	 * @brief Finds the first node with key >= search key
+	 *
+	 * @param search_key Key to search for
+	 * @return Node* The node, or the sentinel if all keys are smaller
+	 */
+	Node *lower_bound_node(const Key &search_key) const
+	{
+		const std::uint64_t prefix{key_prefix(search_key)};
+		return last_node_where(search_key, [&](const Node *node) {
+			return less(node, search_key, prefix);
+		})->forward()[0];
+	}
+
+	/**
+	 * @brief Finds the first node with key > search key
+	 *
+	 * @param search_key Key to search for
+	 * @return Node* The node, or the sentinel if no key is larger
+	 */
+	Node *upper_bound_node(const Key &search_key) const
+	{
+		const std::uint64_t prefix{key_prefix(search_key)};
+		return last_node_where(search_key, [&](const Node *node) {
+			return before(node, search_key, prefix, true);
+		})->forward()[0];
+	}
+
+	/**
+	 * @brief Finds the last node for which the predicate holds, starting from the express-lane
+	 *        index if it is enabled, and from the sentinel otherwise
+	 *
+	 * @param search_key Key to search for, which every node with key < search key satisfies
+	 *                   the predicate for
+	 * @param before Predicate on nodes, which must hold for a prefix of the nodes
+	 * @return Node* The node, or the sentinel if the predicate holds for no node
+	 */
+	template<class Predicate>
+	Node *last_node_where(const Key &search_key, Predicate before) const
+	{
+		Node *node = sentinel;
+		size_t top_level = max_level;
+		// The index copies the keys, so it is left out for keys that can only be moved
+		if constexpr (std::is_copy_constructible<Key>::value) {
+			if (index_enabled) {
+				if (index.needs_rebuild()) {
+					index.build(sentinel, max_level);
+				}
+				// No node of level 2 or more when the index was built lies between the node the
+				// index arrives at and the search key, so only nodes inserted since then are
+				// passed in levels 1 and 0
+				node = index.find_start(search_key, comp);
+				top_level = std::min(std::min(node->level, max_level), 2);
+			}
+		}
+		for (size_t i = top_level; i > 0; i--) {
+			while (node->forward()[i-1] != sentinel && before(node->forward()[i-1])) {
+				node = node->forward()[i-1];
+			}
+		}
+		return node;
+	}
+
+	/**
+	 * @brief Counts the nodes from the start of the Skip List for which the predicate holds,
+	 *        which must hold for a prefix of the nodes
+	 *
+	 * @param before Predicate on nodes
+	 * @return size_t Length of the prefix
+	 */
+	template<class Predicate>
+	size_t count_while(Predicate before) const
+	{
+		const Node *node = sentinel;
+		size_t rank{0};
+		for (size_t i = max_level; i > 0; i--) {
+			while (node->forward()[i-1] != sentinel && before(node->forward()[i-1])) {
+				rank += node->width()[i-1];
+				node = node->forward()[i-1];
+			}
+		}
+		return rank;
+	}
+
+	/**
+	 * @brief Finds the node at the given zero-based position by following the widths
+	 *
+	 * @param position Position of the node
+	 * @return Node* The node, or the sentinel if position >= size()
+	 */
+	Node *select_node(const size_t position) const
+	{
+		if (position >= list_size) {
+			return sentinel;
+		}
+		// Links back to the sentinel reach position n + 1, so they are never followed
+		Node *node = sentinel;
+		size_t rank{0};
+		for (size_t i = max_level; i > 0; i--) {
+			while (rank + node->width()[i-1] <= position + 1) {
+				rank += node->width()[i-1];
+				node = node->forward()[i-1];
+			}
+		}
+		return node;
+	}
+
+	/**
+	 * @brief Traverse the Skip List until an element with key >= search key is found
+	 *
+	 * @param search_key Key to search for
+	 * @param node Reference to the pointer for the node to start from at the top level, which is
+	 *             the sentinel unless continuing from a search finger
+	 * @param update Search path receiving the last node visited at each level and its position
+	 * @param top_level Number of levels to traverse, starting at level top_level - 1 from the
+	 *                  node at that level of the update path
+	 * @param past_equal True to also pass the elements with key equal to the search key, and stop
+	 *                   at the first element with key > search key instead
+	 * @return int Number of comparisons made during traversal
+	 */
+	int traverse_list(const Key &search_key, Node *&node, SearchPath &update, size_t top_level=0,
+	                  const bool past_equal=false) const
+	{
+		size_t rank{0};
+		if (top_level == 0) {
+			top_level = max_level;
+		} else {
+			rank = update.rank[top_level-1];
+		}
+		int comparisons{0};
+		const std::uint64_t prefix{key_prefix(search_key)};
+		bool node_not_sentinel{false};
+		bool key_less_than_search_key{false};
+		for (size_t i = top_level; i > 0; i--) {
+			while ((node_not_sentinel = node->forward()[i-1] != sentinel)
+			      && (key_less_than_search_key = before(node->forward()[i-1], search_key, prefix, past_equal))) {
+				comparisons++;
+				rank += node->width()[i-1];
+				node = node->forward()[i-1];
+			}
+			if (node_not_sentinel && !key_less_than_search_key) {
+				comparisons++;
+			}
+			update.node[i-1] = node;
+			update.rank[i-1] = rank;
+		}
+		node = node->forward()[0];
+		return comparisons;
+	}
+
+	/**
+	 * @brief Traverse the Skip List until an element with key >= search key is found, starting
+	 *        from the path stored in a search finger
+	 *
+	 * The path is left of the search key at level i if its node there is the sentinel or has a
+	 * smaller key, and reaches past it if the node after it at level i is the sentinel or has a
+	 * key >= search key. If the search key is before the finger, climb until the path is left of
+	 * it, and otherwise climb while the next level does not reach past it. The levels above are
+	 * then already correct, and the traversal continues down from the level reached.
+	 *
+	 * @param finger Finger to start from, receiving the new search path
+	 * @param search_key Key to search for
+	 * @param node Reference to the pointer receiving the first node with key >= search key
+	 * @param past_equal True to stop at the first node with key > search key instead
+	 * @return int Number of comparisons made during traversal
+	 */
+	int traverse_list(Finger &finger, const Key &search_key, Node *&node, const bool past_equal=false) const
+	{
+		Node **path = finger.path.node;
+		if (finger.list != this || finger.version != modification_count) {
+			finger.list = this;
+			finger.version = modification_count;
+			node = sentinel;
+			return traverse_list(search_key, node, finger.path, 0, past_equal);
+		}
+
+		int comparisons{0};
+		const std::uint64_t prefix{key_prefix(search_key)};
+		size_t level{0};
+		bool before_finger{false};
+		if (path[0] != sentinel) {
+			comparisons++;
+			before_finger = !before(path[0], search_key, prefix, past_equal);
+		}
+		if (before_finger) {
+			while (++level < static_cast<size_t>(max_level) && path[level] != sentinel) {
+				comparisons++;
+				if (before(path[level], search_key, prefix, past_equal)) {
+					break;
+				}
+			}
+			if (level == static_cast<size_t>(max_level)) {
+				node = sentinel;
+				return comparisons + traverse_list(search_key, node, finger.path, 0, past_equal);
+			}
+		} else {
+			while (level + 1 < static_cast<size_t>(max_level) && path[level+1]->forward()[level+1] != sentinel) {
+				comparisons++;
+				if (!before(path[level+1]->forward()[level+1], search_key, prefix, past_equal)) {
+					break;
+				}
+				level++;
+			}
+		}
+		node = path[level];
+		return comparisons + traverse_list(search_key, node, finger.path, level + 1, past_equal);
+	}
+
+	/**
+	 * @brief Keeps a finger valid after an operation made through it, unless the number of
+	 *        levels in use changed, since the path only covers the levels that were in use
+	 *
+	 * @param finger Finger the operation was made through
+	 * @param level_before Value of max_level before the operation
+	 */
+	void keep_finger(Finger &finger, const int level_before) const
+	{
+		if (max_level == level_before) {
+			finger.version = modification_count;
+		}
+	}
+
+	/**
+	 * @brief Counts an operation towards tuning p, if tuning is on
+	 *
+	 * @param comparisons Number of comparisons made by the traversal of the operation
+	 * @param write True if the operation is an insert or delete
+	 */
+	void record_operation(const int comparisons, const bool write) const
+	{
+		if (tuning) {
+			tuned_operations++;
+			tuned_writes += write;
+			tuned_comparisons += comparisons;
+		}
+	}
+
+	/**
+	 * @brief Work done before every insert or delete: relevels a few nodes if p has changed,
+	 *        and reconsiders p if tuning and enough operations have been counted
+	 *
+	 */
+	void maintain()
+	{
+		if (relevel_rank > 0) {
+			relevel(std::max(RELEVEL_STEP, list_size / RELEVEL_WRITES));
+			// Only operations on the relevelled list tell how well the new p does
+			tuned_operations = 0;
+			tuned_writes = 0;
+			tuned_comparisons = 0;
+		} else if (tuning && tuned_operations >= TUNE_INTERVAL) {
+			double best_p{choose_p()};
+			if (best_p != p) {
+				set_p(best_p);
+			}
+			tuned_operations = 0;
+			tuned_writes = 0;
+			tuned_comparisons = 0;
+		}
+	}
+
+	/**
+	 * @brief Picks the value of TUNED_P with the lowest expected cost per operation for the
+	 *        operations counted, as described for tune_p()
+	 *
+	 * @return double Value of p to use, which is the current one unless another is more than 5%
+	 *                cheaper
+	 */
+	double choose_p() const
+	{
+		if (list_size < 2) {
+			return p;
+		}
+		auto search_cost = [&](const double q) {
+			return std::log2(list_size) / -std::log2(q) / q + 1.0 / (1.0 - q);
+		};
+		double scale{static_cast<double>(tuned_comparisons) / tuned_operations / search_cost(p)};
+		double link_weight{static_cast<double>(tuned_writes) / tuned_operations + tuning_link_cost};
+		auto cost = [&](const double q) {
+			return scale * search_cost(q) + link_weight / (1.0 - q);
+		};
+		double best_p{p};
+		double best_cost{0.95 * cost(p)};
+		for (double q : TUNED_P) {
+			if (cost(q) < best_cost) {
+				best_p = q;
+				best_cost = cost(q);
+			}
+		}
+		return best_p;
+	}
+
+	/**
+	 * @brief Gives the nodes at the given positions new levels drawn with the current p, or
+	 *        with the levels drawn for them before, raised for frequently accessed keys if biased
+	 *
+	 * @param first Position of the first node, from 1
+	 * @param count Number of nodes, at most RELEVEL_WINDOW
+	 * @param redraw True to draw new levels
+	 * @return Node* Node now at the first position
+	 */
+	Node *relevel_window(const size_t first, const size_t count, const bool redraw=true)
+	{
+		// Last node before the window at each level, found by position as in select_node()
+		SearchPath before;
+		Node *node = sentinel;
+		size_t rank{0};
+		for (size_t i = max_level; i > 0; i--) {
+			while (rank + node->width()[i-1] < first) {
+				rank += node->width()[i-1];
+				node = node->forward()[i-1];
+			}
+			before.node[i-1] = node;
+			before.rank[i-1] = rank;
+		}
+		// First node after the window at each level
+		const size_t last{first + count - 1};
+		SearchPath after;
+		for (size_t i = 0; i < static_cast<size_t>(max_level); i++) {
+			node = before.node[i];
+			rank = before.rank[i];
+			while (rank + node->width()[i] <= last) {
+				rank += node->width()[i];
+				node = node->forward()[i];
+			}
+			after.node[i] = node->forward()[i];
+			after.rank[i] = rank + node->width()[i];
+		}
+
+		Node *window[RELEVEL_WINDOW];
+		Node *replaced[RELEVEL_WINDOW];
+		node = before.node[0];
+		for (size_t j = 0; j < count; j++) {
+			node = node->forward()[0];
+			window[j] = node;
+			replaced[j] = nullptr;
+		}
+		size_t j{0};
+		bool changed{false};
+		try {
+			for (; j < count; j++) {
+				int drawn{redraw ? random_level() : window[j]->drawn_level};
+				int level{biased_level(window[j], drawn)};
+				if (!redraw) {
+					// Only lowered once accessed less than half as often as needed for its level, so
+					// that keys at the threshold do not go up and down on every sweep
+					level = std::max(level, std::min(window[j]->level, biased_level(window[j], drawn, 2.0)));
+				}
+				if (level != window[j]->level) {
+					// As for a delete, while the key is still in place, so a biased list keeps its
+					// index instead of rebuilding it. The index stays correct if the node is kept
+					if (index_enabled) {
+						index.remove(window[j], comp);
+						index.record_write();
+					}
+					replaced[j] = window[j];
+					if constexpr (RELOCATES) {
+						window[j] = Node::relocate(node_pool, level, replaced[j]);
+					} else {
+						window[j] = Node::create(node_pool, level, replaced[j]->key(), std::move(replaced[j]->value()));
+					}
+					window[j]->hits = replaced[j]->hits;
+					window[j]->hit_epoch = replaced[j]->hit_epoch;
+					changed = true;
+				}
+				window[j]->drawn_level = static_cast<std::uint8_t>(drawn);
+			}
+		} catch (...) {
+			// Nothing is relinked yet, so the values moved so far are moved back
+			for (size_t k = 0; k < j; k++) {
+				if (replaced[k] == nullptr) {
+					continue;
+				}
+				if constexpr (RELOCATES) {
+					replaced[k]->pair().~value_type();
+					replaced[k]->take_pair(window[k]);
+					Node::destroy_moved(node_pool, window[k]);
+				} else {
+					replaced[k]->value() = std::move(window[k]->value());
+					Node::destroy(node_pool, window[k]);
+				}
+			}
+			throw;
+		}
+		if (!changed) {
+			return window[0];
+		}
+
+		for (size_t k = 0; k < count; k++) {
+			link_backward(window[k], k == 0 ? before.node[0] : window[k-1]);
+			for (size_t i = 0; i < static_cast<size_t>(std::min(window[k]->level, max_level)); i++) {
+				before.node[i]->forward()[i] = window[k];
+				before.node[i]->width()[i] = first + k - before.rank[i];
+				before.node[i] = window[k];
+				before.rank[i] = first + k;
+			}
+		}
+		link_backward(after.node[0], window[count-1]);
+		for (size_t i = 0; i < static_cast<size_t>(max_level); i++) {
+			before.node[i]->forward()[i] = after.node[i];
+			before.node[i]->width()[i] = after.rank[i] - before.rank[i];
+		}
+		for (size_t k = 0; k < count; k++) {
+			if (replaced[k] == nullptr) {
+				continue;
+			}
+			if constexpr (RELOCATES) {
+				Node::destroy_moved(node_pool, replaced[k]);
+			} else {
+				Node::destroy(node_pool, replaced[k]);
+			}
+		}
+		modification_count++;
+		return window[0];
+	}
+
+	/**
+	 * @brief Searches for the given key as search() does, counting the access if biased
+	 *
+	 * @param search_key Key to find
+	 * @param node Receives the node with the key, or the sentinel if the key is not present
+	 * @return int Number of comparisons
+	 */
+	int search_node(const Key &search_key, Node *&node) const
+	{
+		node = sentinel;
+
+		int comparisons{0};
+		const std::uint64_t prefix{key_prefix(search_key)};
+		if (index_enabled) {
+			// Only the comparisons made in the linked list are counted, not those made in the
+			// flat arrays of the index
+			node = last_node_where(search_key, [&](const Node *next) {
+				comparisons++;
+				return less(next, search_key, prefix);
+			});
+		} else {
+			bool node_not_sentinel{false};
+			bool key_less_than_search_key{false};
+			for (size_t i = max_level; i > 0; i--) {
+				while ((node_not_sentinel = node->forward()[i-1] != sentinel)
+				      && (key_less_than_search_key = less(node->forward()[i-1], search_key, prefix))) {
+					comparisons++;
+					node = node->forward()[i-1];
+				}
+				if (node_not_sentinel && !key_less_than_search_key) {
+					comparisons++;
+					// A raised node is first met at its top level, where the search stops if it
+					// holds the key, instead of going on down to level 0. With duplicates, an
+					// equal key may come before it
+					const Node *next = node->forward()[i-1];
+					if (!Duplicates && next->level > next->drawn_level
+					    && i == static_cast<size_t>(std::min(next->level, max_level))) {
+						comparisons++;
+						if (equal(next, search_key, prefix)) {
+							node = node->forward()[i-1];
+							record_operation(comparisons, false);
+							count_access(node);
+							return comparisons;
+						}
+					}
+				}
+			}
+		}
+		node = node->forward()[0];
+		if (node != sentinel) {
+			comparisons++;
+			if (!equal(node, search_key, prefix)) {
+				node = sentinel;
+			}
+		}
+		record_operation(comparisons, false);
+		count_access(node);
+		return comparisons;
+	}
+
+	/**
+	 * @brief Finds the node with the given key, counting the access if biased
+	 *
+	 * @param search_key Key to find
+	 * @return Node* The node, or the sentinel if the key is not present
+	 */
+	Node *find_node(const Key &search_key) const
+	{
+		Node *node = lower_bound_node(search_key);
+		if (node == sentinel || !equal(node, search_key)) {
+			return sentinel;
+		}
+		count_access(node);
+		return node;
+	}
+
+	/**
+	 * @brief Number of accesses after which an access counts half while biased
+	 *
+	 * @return size_t
+	 */
+	size_t half_life() const
+	{
+		return std::max(bias_half_life, list_size);
+	}
+
+	/**
+	 * @brief Halves the accesses counted for a node once for every epoch since they were last
+	 *        updated
+	 *
+	 * @param node Node to update
+	 */
+	void decay(const Node *node) const
+	{
+		const std::uint8_t age{static_cast<std::uint8_t>(bias_epoch - node->hit_epoch)};
+		node->hits = age < 16 ? node->hits >> age : 0;
+		node->hit_epoch = bias_epoch;
+	}
+
+	/**
+	 * @brief Counts an access of a node, if biased, starting a new epoch every half life and
+	 *        decaying the counts of all nodes every BIAS_EPOCH_SWEEP epochs
+	 *
+	 * @param node Node accessed, or the sentinel
+	 */
+	void count_access(const Node *node) const
+	{
+		if (!biasing || node == sentinel) {
+			return;
+		}
+		decay(node);
+		if (node->hits < std::numeric_limits<std::uint16_t>::max()) {
+			node->hits++;
+		}
+		bias_total++;
+		if (++bias_epoch_hits >= half_life()) {
+			bias_epoch++;
+			bias_epoch_hits = 0;
+			bias_total /= 2;
+			// The sweep of rebalance() does not run for const lookups, so the counts it has not
+			// visited are brought up to date here, at a cost of O(1) per access
+			if (bias_epoch % BIAS_EPOCH_SWEEP == 0) {
+				for (const Node *next = sentinel->forward()[0]; next != sentinel; next = next->forward()[0]) {
+					decay(next);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Computes the level a node should have, as described for bias()
+	 *
+	 * @param node Node
+	 * @param drawn Level drawn for the node
+	 * @param weight Factor to weigh the accesses of the node with
+	 * @return int The drawn level, raised to i + 1 if biased and the key is accessed at least
+	 *             (1/p)^i times as often as the average key, but not above the max level
+	 */
+	int biased_level(const Node *node, const int drawn, const double weight=1.0) const
+	{
+		if (!biasing) {
+			return drawn;
+		}
+		decay(node);
+		if (weight * node->hits < BIAS_MIN_HITS) {
+			return drawn;
+		}
+		// Until a half life has passed, the accesses so far are taken as a share of a half life
+		double ratio{weight * node->hits * list_size / std::max(bias_total, half_life())};
+		int level{1};
+		for (double threshold = 1.0 / p; ratio >= threshold && level < max_level; threshold /= p) {
+			level++;
+		}
+		return std::max(drawn, level);
+	}
+
+	/**
+	 * @brief Raises a node just accessed if its key is now accessed often enough, see bias()
+	 *
+	 * @param node Node accessed, or the sentinel
+	 * @return Node* The node, or the node replacing it
+	 */
+	Node *promote(Node *node)
+	{
+		if (!biasing || node == sentinel || biased_level(node, node->drawn_level) <= node->level) {
+			return node;
+		}
+		return relevel_window(rank(node->key()) + 1, 1, false);
+	}
+
+	/**
+	 * @brief Work done before every access while biased: every BIAS_INTERVAL accesses, visits
+	 *        enough nodes to sweep the list once every half life, lowering those whose key is no
+	 *        longer accessed as often
+	 *
+	 */
+	void rebalance()
+	{
+		if (!biasing || ++bias_accesses < BIAS_INTERVAL) {
+			return;
+		}
+		bias_accesses = 0;
+		size_t nodes{std::min(list_size, std::max(RELEVEL_STEP, list_size * BIAS_INTERVAL / half_life()))};
+		while (nodes > 0) {
+			if (bias_rank == 0 || bias_rank > list_size) {
+				bias_rank = 1;
+			}
+			size_t count{std::min(std::min(nodes, RELEVEL_WINDOW), list_size - bias_rank + 1)};
+			relevel_window(bias_rank, count, false);
+			bias_rank += count;
+			nodes -= count;
+		}
+	}
+
+	/**
+	 * @brief Generates a random integer in the range [1,level cap] to use as the level for a
+	 *        new SkipListNode
+	 *
+	 * @return int Positive integer in range [1,level cap]
+	 */
+	int random_level()
+	{
+		return level_distribution(rng);
+	}
+
+	/**
+	 * @brief Computes the number of levels of pointers that should be used in a Skip List of
+	 *        n elements
+	 *
+	 * @param n Number of elements in the Skip List
+	 * @return double The number of levels of pointers that should be used
+	 */
+	double L(const size_t n) const
+	{
+		return std::log2(n) / (-std::log2(p));
+	}
+
+	/**
+	 * @brief Increases the max level of the Skip List
+	 *
+	 */
+	void increase_max_level_of_list()
+	{
+		int level{max_level};
+		Node *r = sentinel;
+		Node *q = r->forward()[level-1];
+		size_t width{r->width()[level-1]};
+		while (q != sentinel) {
+			if (q->level > level) {
+				r->forward()[level] = q;
+				r->width()[level] = width;
+				r = q;
+				width = 0;
+			}
+			width += q->width()[level-1];
+			q = q->forward()[level-1];
+		}
+		r->forward()[level] = sentinel;
+		r->width()[level] = width;
+		max_level++;
+		modification_count++;
+	}
+
+	size_t list_size{};
+
+	// Number of modifications made to the list, used to tell if a search finger is still valid
+	size_t modification_count{0};
+
+	// Upper bound for the number of possible forward pointers
+	const int level_cap{};
+
+	// Number of forward pointers currently in use
+	int max_level{};
+
+	// Constant between (0,1) defining number of elements that are level i or greater
+	double p{};
+
+	Compare comp;
+
+	// Owns the memory of all nodes of the list
+	NodePool node_pool;
+
+	Node *sentinel;
+
+	// Express-lane index over levels 1 and up, only maintained while enabled, keeping its own
+	// copies of std::string_view keys
+	bool index_enabled{false};
+	mutable SkipListIndex<Node, Key, Compare, std::conditional_t<std::is_same_v<Key, std::string_view>, std::string, Key>> index;
+
+	// xoshiro256** engine seeded from std::random_device
+	Xoshiro256 rng;
+
+	// Turns one draw from the engine into a level
+	GeometricLevels level_distribution;
+
+	// Position of the next node to relevel after a change of p, or 0 if there is none
+	size_t relevel_rank{0};
+
+	// Operations counted towards tuning p since it was last reconsidered
+	bool tuning{false};
+	double tuning_link_cost{1.0};
+	mutable size_t tuned_operations{0};
+	mutable size_t tuned_writes{0};
+	mutable size_t tuned_comparisons{0};
+
+	// Settings while biased, the accesses since the last sweep step and the position of the next
+	// node it visits
+	bool biasing{false};
+	size_t bias_half_life{BIAS_HALF_LIFE};
+	size_t bias_accesses{0};
+	size_t bias_rank{0};
+
+	// Current epoch, accesses counted in it, and the sum of the decayed counts of all nodes
+	mutable std::uint8_t bias_epoch{0};
+	mutable size_t bias_epoch_hits{0};
+	mutable size_t bias_total{0};
+};
+
+/**
+ * Skip List keeping every pair inserted, with pairs of equal keys in the order they were inserted
+ */
+template<class Key, class Value, class Compare = std::less<Key>,
+         class Allocator = std::allocator<std::pair<const Key, Value>>, bool BackLinks = false>
+using SkipListMultimap = SkipList<Key, Value, Compare, Allocator, BackLinks, true>;
+} // namespace DM803
+
+#endif // SKIP_LIST_HPP
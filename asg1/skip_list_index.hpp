@@ -0,0 +1,201 @@
+/**
+ * @file skip_list_index.hpp
+ * @brief Read-optimised flat-array index over the upper levels of a Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Express lanes in the style of the cache-sensitive skip list [1]. The keys of the nodes in level 1
+ * of the Skip List are copied into one contiguous array, alongside the nodes themselves. Above it
+ * sit lanes holding every FANOUT-th key of the lane below, until a lane has at most FANOUT keys,
+ * so the position of an entry in the lane below is implicit. A search runs down the lanes,
+ * comparing against at most FANOUT consecutive keys per lane with the compare-and-count kernel of
+ * simd_search.hpp, and finishes on the linked levels 1 and 0 from the node it arrives at.
+ *
+ * The index is a snapshot taken when it is built. Nodes inserted afterwards are simply not in it,
+ * which only lengthens the walk along level 0. A node that is deleted is replaced in the index by
+ * the node of the entry before it, so every entry keeps pointing to a node still in the list with
+ * a key no larger than its own. The index stays correct between rebuilds and only slowly loses
+ * its speed, so rebuilding can wait until enough writes have accumulated. As the keys of deleted
+ * nodes stay in the index, keys that only view bytes owned by their node are copied into a
+ * StoredKey type owning them, such as std::string for std::string_view.
+ *
+ * References:
+ * [1] Stefan Sprenger, Steffen Zeuch and Ulf Leser. Cache-Sensitive Skip List: Efficient Range
+ *     Queries on Modern CPUs. In Data Management on New Hardware, ADMS/IMDM 2016, 1-17, 2017.
+ */
+#ifndef SKIP_LIST_INDEX_HPP
+#define SKIP_LIST_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "simd_search.hpp"
+
+namespace DM803
+{
+template<class Node, class Key, class Compare, class StoredKey = Key>
+class SkipListIndex
+{
+public:
+	/**
+	 * @brief Rebuilds the index from the nodes of a Skip List
+	 *
+	 * @param sentinel Sentinel of the Skip List, whose level 1 is walked to find the nodes
+	 * @param max_level Number of levels in use in the Skip List, above which the links are stale
+	 */
+	void build(Node *sentinel, const int max_level)
+	{
+		this->sentinel = sentinel;
+		keys.clear();
+		nodes.clear();
+		lanes.clear();
+		if (max_level > 1) {
+			for (Node *node = sentinel->forward()[1]; node != sentinel; node = node->forward()[1]) {
+				keys.emplace_back(node->key());
+				nodes.push_back(node);
+			}
+		}
+		for (const std::vector<StoredKey> *below = &keys; below->size() > FANOUT; below = &lanes.back()) {
+			std::vector<StoredKey> lane;
+			lane.reserve((below->size() + FANOUT - 1) / FANOUT);
+			for (size_t i = 0; i < below->size(); i += FANOUT) {
+				lane.push_back((*below)[i]);
+			}
+			lanes.push_back(std::move(lane));
+		}
+		writes_since_build = 0;
+	}
+
+	/**
+	 * @brief Forces a rebuild before the index is used next
+	 *
+	 */
+	void invalidate()
+	{
+		writes_since_build = std::numeric_limits<size_t>::max();
+	}
+
+	/**
+	 * @brief Counts a write to the Skip List since the index was built
+	 *
+	 */
+	void record_write()
+	{
+		if (writes_since_build != std::numeric_limits<size_t>::max()) {
+			writes_since_build++;
+		}
+	}
+
+	/**
+	 * @brief Tells if enough writes have been made since the index was built that searches have
+	 *        slowed down noticeably, which is taken to be once for every 8 nodes in level 1
+	 *
+	 * @return bool True if the index should be rebuilt before it is used
+	 */
+	bool needs_rebuild() const
+	{
+		return writes_since_build == std::numeric_limits<size_t>::max()
+		       || writes_since_build > keys.size() / 8;
+	}
+
+	/**
+	 * @brief Finds a node to continue a search along level 0 from
+	 *
+	 * @param search_key Key to search for
+	 * @param comp Comparator of the Skip List
+	 * @return Node* A node of the list with key < search key, or the sentinel, such that no node
+	 *               in the index lies between it and the search key
+	 */
+	Node *find_start(const Key &search_key, const Compare &comp) const
+	{
+		const std::vector<StoredKey> &top = lanes.empty() ? keys : lanes.back();
+		// Number of entries of the current lane with key < search key
+		size_t position{count_before(top.data(), top.size(), search_key, comp)};
+		for (size_t i = lanes.size(); i > 0; i--) {
+			// Entry position - 1 of the lane above is entry (position - 1) * FANOUT of this one and
+			// has key < search key, while entry position * FANOUT does not
+			const std::vector<StoredKey> &below = i > 1 ? lanes[i-2] : keys;
+			size_t first{position == 0 ? 0 : (position - 1) * FANOUT + 1};
+			size_t last{std::min(position * FANOUT, below.size())};
+			position = first + count_before(below.data() + first, last - first, search_key, comp);
+		}
+		return position == 0 ? sentinel : nodes[position-1];
+	}
+
+	/**
+	 * @brief Replaces a node that is about to be deleted from the Skip List by the node of the
+	 *        entry before it, wherever the index points to it
+	 *
+	 * Only nodes of level 2 or more when the index was built are in it, and entries only ever
+	 * point to such nodes or the sentinel, so other nodes need no work. The keys of the entries
+	 * are left as they are, as the search only relies on them being no smaller than the keys of
+	 * the nodes they point to.
+	 *
+	 * @param node Node about to be deleted
+	 * @param comp Comparator of the Skip List
+	 */
+	void remove(const Node *node, const Compare &comp)
+	{
+		if (node->level < 2) {
+			return;
+		}
+		// Level 1 is too long for the linear count, so the entry is found by binary search
+		size_t position = std::lower_bound(keys.begin(), keys.end(), node->key(), comp) - keys.begin();
+		// Entries of equal keys before it may point to other nodes, or have been redirected
+		while (position < nodes.size() && nodes[position] != node && !comp(node->key(), keys[position])) {
+			position++;
+		}
+		if (position == nodes.size() || nodes[position] != node) {
+			return;
+		}
+		Node *replacement = position == 0 ? sentinel : nodes[position-1];
+		// Entries after it may already have been redirected to it
+		for (; position < nodes.size() && nodes[position] == node; position++) {
+			nodes[position] = replacement;
+		}
+	}
+
+private:
+	/**
+	 * @brief Counts the keys of a lane smaller than the search key, with the vector kernels when
+	 *        the keys are stored as they are
+	 *
+	 * @param lane Keys of the lane, in order
+	 * @param n Number of keys
+	 * @param search_key Key to search for
+	 * @param comp Comparator of the Skip List
+	 * @return size_t Number of keys < search key
+	 */
+	static size_t count_before(const StoredKey *lane, const size_t n, const Key &search_key, const Compare &comp)
+	{
+		if constexpr (std::is_same_v<StoredKey, Key>) {
+			return count_less(lane, n, search_key, comp);
+		} else {
+			return std::lower_bound(lane, lane + n, search_key, comp) - lane;
+		}
+	}
+
+	// Keys per entry of the lane above, and at most in the top lane, which is what the vector
+	// kernels compare in two to four steps for integer keys
+	static constexpr size_t FANOUT{16};
+
+	// Keys and nodes of level 1 of the Skip List
+	std::vector<StoredKey> keys;
+	std::vector<Node *> nodes;
+
+	// Lanes above level 1, from the bottom up
+	std::vector<std::vector<StoredKey>> lanes;
+
+	Node *sentinel{nullptr};
+
+	size_t writes_since_build{std::numeric_limits<size_t>::max()};
+};
+} // namespace DM803
+
+#endif // SKIP_LIST_INDEX_HPP
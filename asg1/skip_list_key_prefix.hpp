@@ -0,0 +1,103 @@
+/**
+ * @file skip_list_key_prefix.hpp
+ * @brief Order-preserving 8 byte prefixes of string keys for the Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Comparing two strings reads the bytes of both, which for a key in a node is one more cache
+ * miss after the one for the node itself. The first 8 bytes of a string, padded with zero bytes
+ * and read as a big-endian unsigned number, order the same way as the strings whenever they
+ * differ, since std::char_traits<char> compares characters as unsigned char. A node of a Skip
+ * List ordered by std::less stores the prefix of its key next to its tower, and a search compares
+ * prefixes first and the whole keys only when they are equal. Keys that differ within their first
+ * 8 bytes are thus ordered without touching their bytes, while keys sharing a longer common start,
+ * or ending in zero bytes, fall back to the full comparison.
+ */
+#ifndef SKIP_LIST_KEY_PREFIX_HPP
+#define SKIP_LIST_KEY_PREFIX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace DM803
+{
+/**
+ * Prefix of keys of any other type, which is never used
+ */
+template<class Key>
+struct SkipListKeyPrefix
+{
+	static constexpr bool enabled{false};
+};
+
+/**
+ * Prefix of keys of type std::string_view, whose bytes the Skip List also keeps in its own memory
+ */
+template<>
+struct SkipListKeyPrefix<std::string_view>
+{
+	static constexpr bool enabled{true};
+
+	/**
+	 * @brief Computes the prefix of a key
+	 *
+	 * @param key Key
+	 * @return std::uint64_t First 8 bytes of the key, padded with zero bytes, most significant
+	 *                       first
+	 */
+	static std::uint64_t of(const std::string_view key)
+	{
+		unsigned char bytes[8]{};
+		if (key.size() >= sizeof(bytes)) {
+			std::memcpy(bytes, key.data(), sizeof(bytes));
+		} else {
+			std::copy(key.begin(), key.end(), bytes);
+		}
+		std::uint64_t prefix{0};
+		for (unsigned char byte : bytes) {
+			prefix = prefix << 8 | byte;
+		}
+		return prefix;
+	}
+};
+
+template<>
+struct SkipListKeyPrefix<std::string> : SkipListKeyPrefix<std::string_view>
+{
+};
+
+/**
+ * @brief Tells if a Skip List with the given key type and comparator stores key prefixes, which
+ *        is when the keys are strings ordered by std::less, transparent or not
+ *
+ * @tparam Key Key type
+ * @tparam Compare Comparator
+ */
+template<class Key, class Compare>
+inline constexpr bool prefixed_keys_v{SkipListKeyPrefix<Key>::enabled
+                                      && (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>)};
+
+/**
+ * Prefix stored in a node, empty when the keys have no prefix so it takes no space
+ */
+template<bool Prefixed>
+struct SkipListNodePrefix
+{
+};
+
+template<>
+struct SkipListNodePrefix<true>
+{
+	std::uint64_t prefix{0};
+};
+} // namespace DM803
+
+#endif // SKIP_LIST_KEY_PREFIX_HPP
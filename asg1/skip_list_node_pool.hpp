@@ -0,0 +1,353 @@
+/**
+ * @file skip_list_node_pool.hpp
+ * @brief Size-classed slab allocator for Skip List nodes
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Nodes are grouped into one size class per tower height. Each class carves its nodes out of
+ * slabs obtained from the allocator, recycles freed nodes through an intrusive free list, and all
+ * slabs are released in bulk when the pool is destroyed. Nodes of the same height allocated close
+ * in time thus end up next to each other in memory.
+ *
+ * Variable-length data stored with the nodes, such as the bytes of string keys, is carved out of
+ * the same slabs in size classes of BYTE_CLASS bytes, and only pieces larger than MAX_CLASS_BYTES
+ * are allocated on their own.
+ *
+ * The slabs of a pool belong to its arena. When nodes move from one list to another, the pool of
+ * the receiving list keeps the arenas of the other pool alive, so the nodes can be released to
+ * its free lists, and the slabs are released once the last pool using them is destroyed.
+ */
+#ifndef SKIP_LIST_NODE_POOL_HPP
+#define SKIP_LIST_NODE_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace DM803
+{
+template<class Allocator>
+class SkipListNodePool
+{
+	// Slabs are allocated in units of max_align_t, which is enough for any node
+	using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::max_align_t>;
+	using block_traits = std::allocator_traits<block_allocator>;
+
+public:
+	/**
+	 * @brief Constructs a new Skip List Node Pool object
+	 *
+	 * @param level_cap Tallest tower the pool has to serve
+	 * @param header_bytes Size of a node without its tower of forward pointers, including any
+	 *                     fixed-size fields stored after the tower
+	 * @param link_bytes Size of one entry of the tower
+	 * @param alignment Alignment of a node, at most that of max_align_t
+	 * @param alloc Allocator to obtain slabs from
+	 */
+	SkipListNodePool(const int level_cap, const std::size_t header_bytes, const std::size_t link_bytes,
+	                 const std::size_t alignment, const Allocator &alloc)
+		: header_bytes(header_bytes),
+		  link_bytes(link_bytes),
+		  alignment(alignment),
+		  arena(new_arena(block_allocator(alloc))),
+		  size_classes(level_cap)
+	{
+	}
+
+	SkipListNodePool(const SkipListNodePool &) = delete;
+	SkipListNodePool &operator=(const SkipListNodePool &) = delete;
+
+	/**
+	 * @brief Allocates memory for a node with a tower of the given height
+	 *
+	 * @param level Number of forward pointers
+	 * @return void* Uninitialised memory for the node
+	 */
+	void *allocate(const int level)
+	{
+		return take(size_classes[level-1], node_bytes(level));
+	}
+
+	/**
+	 * @brief Returns the memory of a node to the free list of its size class
+	 *
+	 * @param node Memory previously returned by allocate(level)
+	 * @param level Number of forward pointers of the node
+	 */
+	void deallocate(void *node, const int level)
+	{
+		give_back(size_classes[level-1], node);
+	}
+
+	/**
+	 * @brief Allocates memory for data of the given size stored with a node
+	 *
+	 * @param bytes Size in bytes, which may be 0
+	 * @return char* Uninitialised memory aligned for a pointer, or nullptr if bytes is 0
+	 */
+	char *allocate_bytes(const std::size_t bytes)
+	{
+		if (bytes == 0) {
+			return nullptr;
+		}
+		if (bytes > MAX_CLASS_BYTES) {
+			return reinterpret_cast<char *>(block_traits::allocate(arena->allocator, blocks_for(bytes)));
+		}
+		std::size_t i{(bytes - 1) / BYTE_CLASS};
+		if (byte_classes.size() <= i) {
+			byte_classes.resize(i + 1);
+		}
+		return static_cast<char *>(take(byte_classes[i], (i + 1) * BYTE_CLASS));
+	}
+
+	/**
+	 * @brief Releases memory returned by allocate_bytes()
+	 *
+	 * @param memory Memory previously returned by allocate_bytes(bytes)
+	 * @param bytes Size passed to allocate_bytes()
+	 */
+	void deallocate_bytes(char *memory, const std::size_t bytes)
+	{
+		if (bytes == 0) {
+			return;
+		}
+		if (bytes > MAX_CLASS_BYTES) {
+			block_traits::deallocate(arena->allocator, reinterpret_cast<std::max_align_t *>(memory), blocks_for(bytes));
+			return;
+		}
+		std::size_t i{(bytes - 1) / BYTE_CLASS};
+		if (byte_classes.size() <= i) {
+			byte_classes.resize(i + 1);
+		}
+		give_back(byte_classes[i], memory);
+	}
+
+	/**
+	 * @brief Tells if the slabs of another pool can be released through this one
+	 *
+	 * @param other Pool to compare with
+	 * @return bool True if the allocators of both pools compare equal
+	 */
+	bool shares_allocator(const SkipListNodePool &other) const
+	{
+		return arena->allocator == other.arena->allocator;
+	}
+
+	/**
+	 * @brief Keeps the slabs of another pool alive for as long as this one, so nodes allocated
+	 *        from it can be released to this one. The pools must serve nodes of the same layout
+	 *
+	 * @param other Pool whose slabs to keep
+	 */
+	void share(const SkipListNodePool &other)
+	{
+		keep(other.arena);
+		for (const auto &kept_arena : other.kept) {
+			keep(kept_arena);
+		}
+	}
+
+	/**
+	 * @brief Takes over all slabs and free nodes of another pool, leaving it with a new arena
+	 *        and nothing allocated. The pools must serve nodes of the same layout and share
+	 *        their allocator
+	 *
+	 * @param other Pool to take the slabs from
+	 */
+	void splice(SkipListNodePool &other)
+	{
+		share(other);
+		other.arena = new_arena(other.arena->allocator);
+		other.kept.clear();
+		splice_free_lists(size_classes, other.size_classes);
+		splice_free_lists(byte_classes, other.byte_classes);
+	}
+
+	/**
+	 * @brief Exchanges the slabs and free nodes of two pools serving nodes of the same layout
+	 *
+	 * @param other Pool to exchange with
+	 */
+	void swap(SkipListNodePool &other)
+	{
+		std::swap(arena, other.arena);
+		std::swap(kept, other.kept);
+		std::swap(size_classes, other.size_classes);
+		std::swap(byte_classes, other.byte_classes);
+	}
+
+	/**
+	 * @brief Returns the allocator slabs are obtained from
+	 *
+	 * @return Allocator
+	 */
+	Allocator get_allocator() const
+	{
+		return Allocator(arena->allocator);
+	}
+
+private:
+	// Number of nodes in the first slab of a size class, doubling with every slab up to the max
+	static constexpr std::size_t MIN_SLAB_NODES{16};
+	static constexpr std::size_t MAX_SLAB_NODES{4096};
+
+	// Granularity of the size classes for data stored with the nodes, and largest size served
+	// from slabs
+	static constexpr std::size_t BYTE_CLASS{16};
+	static constexpr std::size_t MAX_CLASS_BYTES{1024};
+
+	struct FreeNode
+	{
+		FreeNode *next;
+	};
+
+	struct SizeClass
+	{
+		FreeNode *free_list{nullptr};
+
+		// Unused part of the most recent slab
+		char *cursor{nullptr};
+		char *end{nullptr};
+
+		std::size_t slab_nodes{MIN_SLAB_NODES};
+	};
+
+	struct Slab
+	{
+		std::max_align_t *memory;
+		std::size_t blocks;
+	};
+
+	/**
+	 * Slabs obtained by one pool, released all at once when the last pool using them is destroyed
+	 */
+	struct Arena
+	{
+		explicit Arena(const block_allocator &allocator)
+			: allocator(allocator)
+		{
+		}
+
+		Arena(const Arena &) = delete;
+		Arena &operator=(const Arena &) = delete;
+
+		~Arena()
+		{
+			for (const Slab &slab : slabs) {
+				block_traits::deallocate(allocator, slab.memory, slab.blocks);
+			}
+		}
+
+		block_allocator allocator;
+		std::vector<Slab> slabs;
+	};
+
+	static std::shared_ptr<Arena> new_arena(const block_allocator &allocator)
+	{
+		return std::allocate_shared<Arena>(allocator, allocator);
+	}
+
+	/**
+	 * @brief Takes a piece of memory from the free list of a size class, or else from its slab,
+	 *        starting a new slab when the current one is used up
+	 *
+	 * @param size_class Size class to take from
+	 * @param bytes Size of the pieces of the class
+	 * @return void* Uninitialised memory
+	 */
+	void *take(SizeClass &size_class, const std::size_t bytes)
+	{
+		if (size_class.free_list != nullptr) {
+			FreeNode *node = size_class.free_list;
+			size_class.free_list = node->next;
+			return node;
+		}
+		if (size_class.cursor == size_class.end) {
+			std::size_t blocks{blocks_for(size_class.slab_nodes * bytes)};
+			std::max_align_t *memory = block_traits::allocate(arena->allocator, blocks);
+			arena->slabs.push_back(Slab{memory, blocks});
+			size_class.cursor = reinterpret_cast<char *>(memory);
+			size_class.end = size_class.cursor + size_class.slab_nodes * bytes;
+			size_class.slab_nodes = std::min(2 * size_class.slab_nodes, MAX_SLAB_NODES);
+		}
+		void *node = size_class.cursor;
+		size_class.cursor += bytes;
+		return node;
+	}
+
+	static void give_back(SizeClass &size_class, void *node)
+	{
+		size_class.free_list = new (node) FreeNode{size_class.free_list};
+	}
+
+	/**
+	 * @brief Moves the free lists of the size classes of another pool to the matching classes
+	 *        of this one
+	 *
+	 * @param to Size classes of this pool
+	 * @param from Size classes of the other pool, left empty
+	 */
+	static void splice_free_lists(std::vector<SizeClass> &to, std::vector<SizeClass> &from)
+	{
+		if (to.size() < from.size()) {
+			to.resize(from.size());
+		}
+		for (std::size_t i = 0; i < from.size(); i++) {
+			while (from[i].free_list != nullptr) {
+				FreeNode *node = from[i].free_list;
+				from[i].free_list = node->next;
+				give_back(to[i], node);
+			}
+			// The rest of its most recent slab stays unused until the slab is released
+			from[i] = SizeClass{};
+		}
+	}
+
+	static std::size_t blocks_for(const std::size_t bytes)
+	{
+		return (bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+	}
+
+	void keep(const std::shared_ptr<Arena> &other_arena)
+	{
+		if (other_arena != arena && std::find(kept.begin(), kept.end(), other_arena) == kept.end()) {
+			kept.push_back(other_arena);
+		}
+	}
+
+	/**
+	 * @brief Computes the size of a node with a tower of the given height, rounded up so
+	 *        consecutive nodes in a slab stay aligned
+	 *
+	 * @param level Number of forward pointers
+	 * @return std::size_t Size in bytes
+	 */
+	std::size_t node_bytes(const int level) const
+	{
+		std::size_t bytes{std::max(header_bytes + level * link_bytes, sizeof(FreeNode))};
+		return (bytes + alignment - 1) / alignment * alignment;
+	}
+
+	const std::size_t header_bytes{};
+	const std::size_t link_bytes{};
+	const std::size_t alignment{};
+
+	// Arena new slabs are added to
+	std::shared_ptr<Arena> arena;
+
+	// Arenas of other pools that nodes released to this one may come from
+	std::vector<std::shared_ptr<Arena>> kept;
+
+	std::vector<SizeClass> size_classes;
+
+	// Size classes of data stored with the nodes, grown as larger pieces are asked for
+	std::vector<SizeClass> byte_classes;
+};
+} // namespace DM803
+
+#endif // SKIP_LIST_NODE_POOL_HPP
@@ -0,0 +1,1421 @@
+/**
+ * @file skip_list_test.cpp
+ * @brief Randomised test for the sequential Skip List
+ * @date 2026-10-16
+ *
+ * DM803 Advanced Data Structures
+ *
+ * Exam Project - Part 1 - Spring 2022
+ *
+ * Runs random operations against the Skip List through each of its interfaces and checks every
+ * result, and the final contents, against a std::map, or a std::multimap for a list keeping
+ * duplicate keys. Then does the same for the Deterministic Skip List, also checking its bound on
+ * the height, and for the Block Skip List with several block sizes, also checking that every block
+ * but the last is at least half full.
+ */
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "block_skip_list.hpp"
+#include "deterministic_skip_list.hpp"
+#include "skip_list.hpp"
+
+using List = DM803::SkipList<int, int>;
+using BackLinkedList = DM803::SkipList<int, int, std::less<int>, std::allocator<std::pair<const int, int>>, true>;
+using Multimap = DM803::SkipListMultimap<int, int>;
+
+/**
+ * @brief Prints a helper message to stdout for how to use this program
+ *
+ * @param program First argument from the command line, i.e. argv[0]
+ */
+static void show_usage(const std::string& program)
+{
+	std::cout << "Usage: " << program << " [<operations>]\n"
+	          << "Arguments:\n"
+	          << "\toperations\tOptional: Number of operations per phase. Default value is 100000.\n"
+	          << std::endl;
+}
+
+/**
+ * @brief Checks that the list holds exactly the pairs of the reference map, in the same order
+ *
+ * @param l List to check
+ * @param reference Expected contents
+ * @param phase Name of the phase, used in error messages
+ * @return bool True if the list passed the check
+ */
+template<class L, class M>
+static bool check_list(const L &l, const M &reference, const std::string &phase)
+{
+	auto expected = reference.begin();
+	size_t visited{0};
+	bool matches{true};
+	for (const auto &element : l) {
+		matches = matches && expected != reference.end() && expected->first == element.first
+		          && expected->second == element.second;
+		if (expected != reference.end()) {
+			++expected;
+		}
+		visited++;
+	}
+	if (!matches || visited != reference.size() || l.size() != reference.size()) {
+		std::cout << "F - " << phase << ": expected " << reference.size() << " keys, visited " << visited
+		          << (matches ? "" : ", contents differ") << ", size() reports " << l.size() << std::endl;
+		return false;
+	}
+	std::cout << "S - " << phase << ": " << visited << " keys" << std::endl;
+	return true;
+}
+
+/**
+ * @brief Reports the first operation whose result differs from the reference
+ *
+ * @param phase Name of the phase
+ * @param operation Description of the operation
+ * @param key Key of the operation
+ * @param i Number of operations made before
+ * @return bool Always false
+ */
+template<class K>
+static bool report(const std::string &phase, const std::string &operation, const K &key, const int i)
+{
+	std::cout << "F - " << phase << ": " << operation << " of '" << key << "' after " << i << " operations"
+	          << std::endl;
+	return false;
+}
+
+/**
+ * @brief Searches, inserts and deletes through a finger, mostly close to the key before and now
+ *        and then far from it or after a change made without the finger
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool finger_search(const int operations)
+{
+	const std::string phase{"finger search"};
+	List l;
+	List::Finger finger;
+	std::map<int, int> reference;
+	std::mt19937 rng(5);
+	std::uniform_int_distribution<> key_distribution(0, operations);
+	std::uniform_int_distribution<> step_distribution(-20, 20);
+	int key{0};
+	for (int i = 0; i < operations; i++) {
+		int operation{static_cast<int>(rng() % 20)};
+		key = operation == 0 ? key_distribution(rng) : key + step_distribution(rng);
+		if (operation == 1) {
+			// Leaves the finger behind, so its next use has to start over
+			if (l.insert(key, i).second != reference.emplace(key, i).second) {
+				return report(phase, "insert without finger", key, i);
+			}
+		} else if (operation < 10) {
+			if (l.insert(finger, key, i).second != reference.emplace(key, i).second) {
+				return report(phase, "insert", key, i);
+			}
+		} else if (operation < 14) {
+			if (l.remove(finger, key).second != (reference.erase(key) > 0)) {
+				return report(phase, "remove", key, i);
+			}
+		} else if (l.search(finger, key).second != (reference.count(key) > 0)) {
+			return report(phase, "search", key, i);
+		}
+	}
+	return check_list(l, reference, phase);
+}
+
+/**
+ * @brief Makes random inserts and deletes in a list and its reference, and checks each result
+ *
+ * @param l List to change
+ * @param reference Reference to change alike
+ * @param operations Number of operations
+ * @param rng Random number generator
+ * @param phase Name of the phase
+ * @return bool True if every result agreed with the reference
+ */
+template<class L>
+static bool churn(L &l, std::map<int, int> &reference, const int operations, std::mt19937 &rng,
+                  const std::string &phase)
+{
+	std::uniform_int_distribution<> key_distribution(0, 2 * operations);
+	for (int i = 0; i < operations; i++) {
+		int key{key_distribution(rng)};
+		if (rng() % 2 == 0) {
+			if (l.insert(key, i).second != reference.emplace(key, i).second) {
+				return report(phase, "insert", key, i);
+			}
+		} else if (l.remove(key).second != (reference.erase(key) > 0)) {
+			return report(phase, "remove", key, i);
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Loads lists from sorted ranges and streams with both kinds of levels, checks that
+ *        unsorted input and non-empty lists are refused, and that loaded lists take further
+ *        inserts and deletes
+ *
+ * @param operations Number of pairs to load
+ * @return bool True if the phase passed
+ */
+static bool bulk_load(const int operations)
+{
+	std::mt19937 rng(6);
+	std::map<int, int> reference;
+	for (int key = 0; static_cast<int>(reference.size()) < operations; key += 1 + rng() % 3) {
+		reference.emplace(key, static_cast<int>(rng() % 1000));
+	}
+	std::vector<std::pair<int, int>> pairs(reference.begin(), reference.end());
+	std::ostringstream text;
+	for (const auto &element : pairs) {
+		text << element.first << " " << element.second << "\n";
+	}
+	bool passed{true};
+	for (DM803::BulkLoadLevels levels : {DM803::BulkLoadLevels::random, DM803::BulkLoadLevels::ideal}) {
+		const std::string name{levels == DM803::BulkLoadLevels::random ? "random" : "ideal"};
+		const std::string phase{"bulk load of a range with " + name + " levels"};
+		List from_range(pairs.begin(), pairs.end(), levels);
+		std::map<int, int> expected(reference);
+		passed = check_list(from_range, expected, phase) && passed;
+		if (from_range.bulk_load(pairs.begin(), pairs.end(), levels)) {
+			passed = report(phase, "load into a non-empty list", pairs.front().first, 0);
+		}
+		passed = churn(from_range, expected, operations, rng, phase)
+		         && check_list(from_range, expected, phase + " and churn") && passed;
+
+		std::istringstream in(text.str());
+		List from_stream(in, levels);
+		passed = check_list(from_stream, reference, "bulk load of a stream with " + name + " levels") && passed;
+	}
+
+	// Loading stops at the first key out of order, keeping the pairs before it
+	std::vector<std::pair<int, int>> unsorted(pairs);
+	const size_t out_of_order{unsorted.size() / 2};
+	unsorted[out_of_order].first = unsorted[out_of_order - 1].first;
+	List l;
+	if (l.bulk_load(unsorted.begin(), unsorted.end())) {
+		passed = report("bulk load of unsorted pairs", "load", unsorted[out_of_order].first, out_of_order);
+	}
+	std::map<int, int> prefix(pairs.begin(), pairs.begin() + out_of_order);
+	passed = check_list(l, prefix, "bulk load of unsorted pairs") && passed;
+	return passed;
+}
+
+/**
+ * @brief Tells if an iterator into the list and one into the reference point to the same pair,
+ *        or are both at the end
+ *
+ * @param it Iterator into the list
+ * @param end End of the list
+ * @param expected Iterator into the reference
+ * @param reference Reference
+ * @return bool True if both point to equal pairs or both are at the end
+ */
+template<class It, class M>
+static bool same_position(const It &it, const It &end, const typename M::const_iterator &expected,
+                          const M &reference)
+{
+	if (it == end || expected == reference.end()) {
+		return (it == end) == (expected == reference.end());
+	}
+	return it->first == expected->first && it->second == expected->second;
+}
+
+/**
+ * @brief Looks keys up through find(), lower_bound() and upper_bound(), changes values through
+ *        the iterators returned, and scans ranges with range_scan() and with iterators
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool iterators(const int operations)
+{
+	const std::string phase{"iterators"};
+	std::mt19937 rng(7);
+	List l;
+	std::map<int, int> reference;
+	if (!churn(l, reference, operations, rng, phase)) {
+		return false;
+	}
+	const List &const_l = l;
+	std::uniform_int_distribution<> key_distribution(-10, 2 * operations + 10);
+	for (int i = 0; i < operations; i++) {
+		int key{key_distribution(rng)};
+		switch (rng() % 5) {
+		case 0: {
+			auto it = l.find(key);
+			auto expected = reference.find(key);
+			if (!same_position(it, l.end(), expected, reference)) {
+				return report(phase, "find", key, i);
+			}
+			if (it != l.end()) {
+				it->second = i;
+				expected->second = i;
+			}
+			break;
+		}
+		case 1:
+			if (!same_position(const_l.lower_bound(key), const_l.end(), reference.lower_bound(key), reference)) {
+				return report(phase, "lower_bound", key, i);
+			}
+			break;
+		case 2:
+			if (!same_position(const_l.upper_bound(key), const_l.end(), reference.upper_bound(key), reference)) {
+				return report(phase, "upper_bound", key, i);
+			}
+			break;
+		case 3: {
+			auto expected = reference.lower_bound(key);
+			auto expected_end = reference.upper_bound(key + 50);
+			bool matches{true};
+			size_t visited{l.range_scan(key, key + 50, [&](const int k, const int v) {
+				matches = matches && expected != expected_end && expected->first == k && expected->second == v;
+				if (expected != expected_end) {
+					++expected;
+				}
+			})};
+			size_t expected_count{static_cast<size_t>(std::distance(reference.lower_bound(key), expected_end))};
+			if (!matches || expected != expected_end || visited != expected_count) {
+				return report(phase, "range_scan", key, i);
+			}
+			break;
+		}
+		default:
+			if (std::distance(l.lower_bound(key), l.upper_bound(key + 50))
+			    != std::distance(reference.lower_bound(key), reference.upper_bound(key + 50))) {
+				return report(phase, "iteration", key, i);
+			}
+		}
+	}
+	// An empty range visits nothing, and an iterator converts to a const_iterator to the same pair
+	List::const_iterator first(l.begin());
+	if (l.range_scan(10, 5, [](const int, const int) {}) != 0 || first != const_l.begin()) {
+		return report(phase, "range_scan", 10, operations);
+	}
+	return check_list(l, reference, phase);
+}
+
+/**
+ * @brief Checks rank(), select() and count_range() against the positions of the keys in a sorted
+ *        copy of the reference, in rounds between which the list is changed, starting from a
+ *        bulk loaded list
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool order_statistics(const int operations)
+{
+	const std::string phase{"order statistics"};
+	std::mt19937 rng(8);
+	std::map<int, int> reference;
+	for (int key = 0; key < operations; key += 2) {
+		reference.emplace(key, key);
+	}
+	List l(reference.begin(), reference.end(), DM803::BulkLoadLevels::ideal);
+	std::uniform_int_distribution<> key_distribution(-10, 2 * operations + 10);
+	const int rounds{10};
+	for (int round = 0; round < rounds; round++) {
+		std::vector<int> keys;
+		for (const auto &element : reference) {
+			keys.push_back(element.first);
+		}
+		for (int i = 0; i < operations / rounds; i++) {
+			int key{key_distribution(rng)};
+			size_t position{static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin())};
+			if (l.rank(key) != position) {
+				return report(phase, "rank", key, i);
+			}
+			auto selected = l.select(position);
+			bool found{selected != l.end()};
+			if (found != (position < keys.size()) || (found && selected->first != keys[position])) {
+				return report(phase, "select", key, i);
+			}
+			int hi{key + static_cast<int>(rng() % 1000) - 100};
+			size_t expected{hi < key ? 0 : static_cast<size_t>(std::upper_bound(keys.begin(), keys.end(), hi)
+			                                                   - keys.begin()) - position};
+			if (l.count_range(key, hi) != expected) {
+				return report(phase, "count_range", key, i);
+			}
+		}
+		if (!churn(l, reference, operations / rounds, rng, phase)) {
+			return false;
+		}
+	}
+	return check_list(l, reference, phase);
+}
+
+/**
+ * @brief Looks up batches of keys, present or not, in groups of several sizes, and changes values
+ *        through the pointers returned
+ *
+ * @param operations Number of keys looked up in each group size
+ * @return bool True if the phase passed
+ */
+static bool batch_search(const int operations)
+{
+	const std::string phase{"batch search"};
+	std::mt19937 rng(11);
+	List l;
+	std::map<int, int> reference;
+	if (!churn(l, reference, operations, rng, phase)) {
+		return false;
+	}
+	const List &const_l = l;
+	std::uniform_int_distribution<> key_distribution(-10, 2 * operations + 10);
+	std::vector<int> keys;
+	std::vector<int *> results;
+	std::vector<const int *> const_results;
+	for (int i = 0; i < operations; i += keys.size()) {
+		// Batch sizes not divisible by the group size leave a partial group at the end
+		keys.resize(1 + rng() % 100);
+		for (int &key : keys) {
+			key = key_distribution(rng);
+		}
+		results.assign(keys.size(), nullptr);
+		const_results.assign(keys.size(), nullptr);
+		switch (i % 3) {
+		case 0:
+			l.search_batch(keys.data(), keys.size(), results.data());
+			const_l.search_batch(keys.data(), keys.size(), const_results.data());
+			break;
+		case 1:
+			l.search_batch<1>(keys.data(), keys.size(), results.data());
+			const_l.search_batch<1>(keys.data(), keys.size(), const_results.data());
+			break;
+		default:
+			l.search_batch<7>(keys.data(), keys.size(), results.data());
+			const_l.search_batch<7>(keys.data(), keys.size(), const_results.data());
+		}
+		for (size_t j = 0; j < keys.size(); j++) {
+			auto expected = reference.find(keys[j]);
+			bool found{expected != reference.end()};
+			if ((results[j] != nullptr) != found || results[j] != const_results[j]
+			    || (found && *results[j] != expected->second)) {
+				return report(phase, "search_batch", keys[j], i);
+			}
+			if (found) {
+				*results[j] = i;
+				expected->second = i;
+			}
+		}
+	}
+	return check_list(l, reference, phase);
+}
+
+/**
+ * @brief Fills an empty list and its reference with random keys
+ *
+ * @param l List to fill
+ * @param reference Reference to fill alike
+ * @param size Number of keys
+ * @param range Keys are drawn from [0, range)
+ * @param value Value stored for key k is k + value
+ * @param rng Random number generator
+ */
+template<class L>
+static void fill(L &l, std::map<int, int> &reference, const int size, const int range, const int value,
+                 std::mt19937 &rng)
+{
+	while (static_cast<int>(reference.size()) < size) {
+		int key{static_cast<int>(rng() % range)};
+		reference.emplace(key, key + value);
+		l.insert(key, key + value);
+	}
+}
+
+/**
+ * @brief Takes the union, intersection and difference of random lists, of equal sizes for the
+ *        merging paths and of very different sizes for the finger search paths, then changes the
+ *        results to check that their towers were rebuilt correctly
+ *
+ * @param operations Size of the larger lists
+ * @return bool True if the phase passed
+ */
+static bool set_operations(const int operations)
+{
+	std::mt19937 rng(15);
+	bool passed{true};
+	const int small{std::max(1, operations / (2 * static_cast<int>(List::FINGER_MERGE_RATIO)))};
+	for (const auto &sizes : {std::make_pair(operations, operations), std::make_pair(operations, small),
+	                          std::make_pair(small, operations)}) {
+		const std::string name{" of " + std::to_string(sizes.first) + " and " + std::to_string(sizes.second) + " keys"};
+		for (int operation = 0; operation < 3; operation++) {
+			List l;
+			List other;
+			std::map<int, int> reference;
+			std::map<int, int> other_reference;
+			fill(l, reference, sizes.first, 2 * operations, 0, rng);
+			fill(other, other_reference, sizes.second, 2 * operations, 1, rng);
+			std::string phase;
+			if (operation == 0) {
+				phase = "union" + name;
+				if (!l.union_with(other) || !other.empty()) {
+					passed = report(phase, "union_with", 0, 0);
+					continue;
+				}
+				// Keys in both lists keep the value of this one
+				reference.insert(other_reference.begin(), other_reference.end());
+			} else {
+				phase = (operation == 1 ? "intersection" : "difference") + name;
+				if (operation == 1) {
+					l.intersect_with(other);
+				} else {
+					l.difference_with(other);
+				}
+				for (auto it = reference.begin(); it != reference.end(); ) {
+					bool in_other{other_reference.count(it->first) > 0};
+					it = in_other != (operation == 1) ? reference.erase(it) : std::next(it);
+				}
+				passed = check_list(other, other_reference, phase + ", other list") && passed;
+			}
+			passed = check_list(l, reference, phase) && churn(l, reference, operations / 10, rng, phase)
+			         && check_list(l, reference, phase + " and churn") && passed;
+		}
+	}
+
+	// With itself, union and intersection change nothing and difference empties the list
+	List l;
+	std::map<int, int> reference;
+	fill(l, reference, small, 2 * operations, 0, rng);
+	l.intersect_with(l);
+	passed = l.union_with(l) && check_list(l, reference, "union and intersection with itself") && passed;
+	l.difference_with(l);
+	reference.clear();
+	passed = check_list(l, reference, "difference with itself") && passed;
+	return passed;
+}
+
+/**
+ * @brief Checks that select() finds every key of the reference at its position, which only holds
+ *        if the widths of the towers are right
+ *
+ * @param l List to check
+ * @param reference Expected contents
+ * @param phase Name of the phase, used in error messages
+ * @return bool True if the positions agreed
+ */
+static bool check_positions(const List &l, const std::map<int, int> &reference, const std::string &phase)
+{
+	size_t position{0};
+	for (const auto &element : reference) {
+		auto selected = l.select(position);
+		if (selected == l.end() || selected->first != element.first || l.rank(element.first) != position) {
+			return report(phase, "select", element.first, position);
+		}
+		position++;
+	}
+	return l.select(position) == l.end() || report(phase, "select past the end", 0, position);
+}
+
+/**
+ * @brief Splits a list at random keys, including keys before and after all keys in it, checks
+ *        both parts, and concatenates them again, also in the wrong order, which is refused, then
+ *        checks that the part split off keeps the settings of the list
+ *
+ * @param operations Number of keys in the list
+ * @return bool True if the phase passed
+ */
+static bool split_concat(const int operations)
+{
+	std::mt19937 rng(16);
+	List l;
+	std::map<int, int> reference;
+	fill(l, reference, operations, 4 * operations, 0, rng);
+	bool passed{true};
+	const int rounds{8};
+	for (int round = 0; round < rounds && passed; round++) {
+		int split_key{round == 0 ? -1 : round == 1 ? 4 * operations : static_cast<int>(rng() % (4 * operations))};
+		const std::string phase{"split at '" + std::to_string(split_key) + "'"};
+		List upper(l.split(split_key));
+		std::map<int, int> upper_reference(reference.lower_bound(split_key), reference.end());
+		reference.erase(reference.lower_bound(split_key), reference.end());
+		passed = check_list(l, reference, phase + ", lower part") && check_positions(l, reference, phase)
+		         && check_list(upper, upper_reference, phase + ", upper part")
+		         && check_positions(upper, upper_reference, phase);
+		if (!reference.empty() && !upper_reference.empty() && upper.concat(l)) {
+			passed = report(phase, "concat in the wrong order", split_key, round);
+		}
+		if (!l.concat(upper) || !upper.empty()) {
+			passed = report(phase, "concat", split_key, round);
+		}
+		reference.insert(upper_reference.begin(), upper_reference.end());
+		passed = check_list(l, reference, phase + " and concat") && check_positions(l, reference, phase)
+		         && churn(l, reference, operations / rounds, rng, phase) && passed;
+	}
+
+	// Concatenating onto an empty list, or an empty list onto another, moves all or nothing
+	List empty;
+	if (!empty.concat(l) || !l.empty() || !empty.concat(l)) {
+		passed = report("concat with an empty list", "concat", 0, 0);
+	}
+	passed = check_list(empty, reference, "concat with an empty list") && passed;
+
+	// The part split off uses the index, tuning and biasing like the list, also when it is empty
+	List settings;
+	std::map<int, int> settings_reference;
+	fill(settings, settings_reference, 1000, 2000, 0, rng);
+	settings.use_index(true);
+	settings.tune_p(true);
+	settings.bias(true);
+	for (int split_key : {2000, 1000}) {
+		List upper(settings.split(split_key));
+		if (!upper.uses_index() || !upper.tunes_p() || !upper.biased()) {
+			passed = report("split with settings", "split", split_key, 0);
+		}
+		settings.concat(upper);
+	}
+	passed = check_list(settings, settings_reference, "split with settings and concat") && passed;
+	return passed;
+}
+
+/**
+ * @brief Makes random inserts, deletes and lookups through search(), get(), lower_bound() and
+ *        upper_bound() in a list and its reference, and checks each result
+ *
+ * @param l List to change
+ * @param reference Reference to change alike
+ * @param operations Number of operations
+ * @param lo Keys are drawn from [lo, hi]
+ * @param hi Keys are drawn from [lo, hi]
+ * @param rng Random number generator
+ * @param phase Name of the phase
+ * @return bool True if every result agreed with the reference
+ */
+static bool lookups(List &l, std::map<int, int> &reference, const int operations, const int lo, const int hi,
+                    std::mt19937 &rng, const std::string &phase)
+{
+	const List &const_l = l;
+	std::uniform_int_distribution<> key_distribution(lo, hi);
+	for (int i = 0; i < operations; i++) {
+		int key{key_distribution(rng)};
+		switch (rng() % 6) {
+		case 0:
+			if (l.insert(key, i).second != reference.emplace(key, i).second) {
+				return report(phase, "insert", key, i);
+			}
+			break;
+		case 1:
+			if (l.remove(key).second != (reference.erase(key) > 0)) {
+				return report(phase, "remove", key, i);
+			}
+			break;
+		case 2:
+			if (l.search(key).second != (reference.count(key) > 0)) {
+				return report(phase, "search", key, i);
+			}
+			break;
+		case 3: {
+			const int *value = const_l.get(key);
+			auto expected = reference.find(key);
+			if ((value != nullptr) != (expected != reference.end()) || (value != nullptr && *value != expected->second)) {
+				return report(phase, "get", key, i);
+			}
+			break;
+		}
+		case 4:
+			if (!same_position(const_l.lower_bound(key), const_l.end(), reference.lower_bound(key), reference)) {
+				return report(phase, "lower_bound", key, i);
+			}
+			break;
+		default:
+			if (!same_position(const_l.upper_bound(key), const_l.end(), reference.upper_bound(key), reference)) {
+				return report(phase, "upper_bound", key, i);
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Changes and looks up keys in a list with the index on, so that lookups meet the index
+ *        right after a rebuild and with many writes it has not seen yet, also after set operations,
+ *        splits and concatenations, which rebuild the towers under it
+ *
+ * @param operations Number of operations in each round
+ * @return bool True if the phase passed
+ */
+static bool express_lanes(const int operations)
+{
+	const std::string phase{"express lanes"};
+	std::mt19937 rng(12);
+	List l;
+	std::map<int, int> reference;
+	bool passed{churn(l, reference, operations, rng, phase)};
+	l.use_index(true);
+	passed = passed && lookups(l, reference, operations, -10, 2 * operations + 10, rng, phase)
+	         && check_list(l, reference, phase);
+
+	const std::string operation_names[]{"union", "difference", "intersection"};
+	for (int operation = 0; operation < 3 && passed; operation++) {
+		const std::string name{phase + " after " + operation_names[operation]};
+		List other;
+		std::map<int, int> other_reference;
+		fill(other, other_reference, operations / 2, 2 * operations, 1, rng);
+		other.use_index(true);
+		if (operation == 0) {
+			l.union_with(other);
+			reference.insert(other_reference.begin(), other_reference.end());
+		} else {
+			if (operation == 1) {
+				l.difference_with(other);
+			} else {
+				l.intersect_with(other);
+			}
+			for (auto it = reference.begin(); it != reference.end(); ) {
+				bool in_other{other_reference.count(it->first) > 0};
+				it = in_other == (operation == 1) ? reference.erase(it) : std::next(it);
+			}
+		}
+		passed = lookups(l, reference, operations, -10, 2 * operations + 10, rng, name)
+		         && check_list(l, reference, name);
+	}
+
+	if (passed) {
+		// Both parts keep the index on, and each is changed within its own range of keys
+		List upper(l.split(operations));
+		std::map<int, int> upper_reference(reference.lower_bound(operations), reference.end());
+		reference.erase(reference.lower_bound(operations), reference.end());
+		passed = upper.uses_index() && lookups(l, reference, operations, -10, operations - 1, rng, phase)
+		         && check_list(l, reference, phase + ", lower part")
+		         && lookups(upper, upper_reference, operations, operations, 2 * operations + 10, rng, phase)
+		         && check_list(upper, upper_reference, phase + ", upper part") && l.concat(upper);
+		reference.insert(upper_reference.begin(), upper_reference.end());
+		passed = passed && lookups(l, reference, operations, -10, 2 * operations + 10, rng, phase + " after concat")
+		         && check_list(l, reference, phase + " after concat");
+	}
+	return passed;
+}
+
+/**
+ * @brief Checks that walking a list with backward pointers from the end visits the pairs of the
+ *        reference in reverse, both through reverse iterators and by decrementing
+ *
+ * @param l List to check
+ * @param reference Expected contents
+ * @param phase Name of the phase, used in error messages
+ * @return bool True if the list passed the check
+ */
+static bool check_reverse(const BackLinkedList &l, const std::map<int, int> &reference, const std::string &phase)
+{
+	if (!std::equal(l.rbegin(), l.rend(), reference.rbegin(), reference.rend())) {
+		return report(phase, "reverse iteration", 0, 0);
+	}
+	auto it = l.end();
+	for (auto expected = reference.rbegin(); expected != reference.rend(); ++expected) {
+		if (it == l.begin() || (--it)->first != expected->first) {
+			return report(phase, "decrement", expected->first, 0);
+		}
+	}
+	return it == l.begin() || report(phase, "decrement past the first pair", 0, 0);
+}
+
+/**
+ * @brief Looks keys up with floor(), ceiling(), predecessor() and successor() in a list with
+ *        backward pointers, and walks it backwards after inserts, deletes, set operations, splits
+ *        and concatenations, which all have to keep the backward pointers
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool back_links(const int operations)
+{
+	std::mt19937 rng(17);
+	BackLinkedList l;
+	std::map<int, int> reference;
+	bool passed{churn(l, reference, operations, rng, "back links")};
+	std::uniform_int_distribution<> key_distribution(-10, 2 * operations + 10);
+	for (int round = 0; round < 4 && passed; round++) {
+		const std::string phase{"back links, round " + std::to_string(round)};
+		for (int i = 0; i < operations / 4 && passed; i++) {
+			int key{key_distribution(rng)};
+			auto above = reference.upper_bound(key);
+			auto at_least = reference.lower_bound(key);
+			auto at_most = above == reference.begin() ? reference.end() : std::prev(above);
+			auto below = at_least == reference.begin() ? reference.end() : std::prev(at_least);
+			if (!same_position(l.floor(key), l.end(), at_most, reference)) {
+				passed = report(phase, "floor", key, i);
+			} else if (!same_position(l.ceiling(key), l.end(), at_least, reference)) {
+				passed = report(phase, "ceiling", key, i);
+			} else if (!same_position(l.predecessor(key), l.end(), below, reference)) {
+				passed = report(phase, "predecessor", key, i);
+			} else if (!same_position(l.successor(key), l.end(), above, reference)) {
+				passed = report(phase, "successor", key, i);
+			}
+		}
+		passed = passed && check_reverse(l, reference, phase);
+
+		// Each round reshapes the list in another way before the next round of lookups
+		BackLinkedList other;
+		std::map<int, int> other_reference;
+		if (round == 0) {
+			fill(other, other_reference, operations / 2, 2 * operations, 1, rng);
+			l.union_with(other);
+			reference.insert(other_reference.begin(), other_reference.end());
+		} else if (round == 1) {
+			fill(other, other_reference, operations / 2, 2 * operations, 1, rng);
+			l.difference_with(other);
+			for (const auto &element : other_reference) {
+				reference.erase(element.first);
+			}
+			passed = passed && check_reverse(other, other_reference, phase + ", other list");
+		} else if (round == 2) {
+			BackLinkedList upper(l.split(operations));
+			std::map<int, int> upper_reference(reference.lower_bound(operations), reference.end());
+			reference.erase(reference.lower_bound(operations), reference.end());
+			passed = passed && check_reverse(l, reference, phase + ", lower part")
+			         && check_reverse(upper, upper_reference, phase + ", upper part") && l.concat(upper);
+			reference.insert(upper_reference.begin(), upper_reference.end());
+		}
+	}
+	return check_list(l, reference, "back links") && check_reverse(l, reference, "back links") && passed;
+}
+
+/**
+ * @brief Inserts and updates keys with try_emplace(), insert_or_assign() and operator[], and
+ *        checks that try_emplace() leaves its arguments alone when the key is present
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool map_interface(const int operations)
+{
+	const std::string phase{"map interface"};
+	std::mt19937 rng(19);
+	List l;
+	std::map<int, int> reference;
+	std::uniform_int_distribution<> key_distribution(0, operations);
+	for (int i = 0; i < operations; i++) {
+		int key{key_distribution(rng)};
+		switch (rng() % 4) {
+		case 0: {
+			auto result = l.try_emplace(key, i);
+			auto expected = reference.try_emplace(key, i);
+			if (result.second != expected.second || result.first == l.end() || result.first->first != key
+			    || result.first->second != expected.first->second) {
+				return report(phase, "try_emplace", key, i);
+			}
+			break;
+		}
+		case 1: {
+			auto result = l.insert_or_assign(key, i);
+			if (result.second != reference.insert_or_assign(key, i).second || result.first->second != i) {
+				return report(phase, "insert_or_assign", key, i);
+			}
+			break;
+		}
+		case 2:
+			l[key] += i;
+			reference[key] += i;
+			break;
+		default:
+			if (l.remove(key).second != (reference.erase(key) > 0)) {
+				return report(phase, "remove", key, i);
+			}
+		}
+	}
+	bool passed{check_list(l, reference, phase)};
+
+	DM803::SkipList<int, std::string> strings;
+	std::string value("first");
+	strings.try_emplace(1, std::move(value));
+	value = "second";
+	auto result = strings.try_emplace(1, std::move(value));
+	if (result.second || result.first->second != "first" || value != "second") {
+		passed = report(phase, "try_emplace of a present key", 1, 0);
+	}
+	return passed;
+}
+
+/**
+ * @brief Inserts and removes keys, many of them several times, in a list keeping duplicate keys,
+ *        and checks count() and the order of equal_range() against a std::multimap
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool duplicate_keys(const int operations)
+{
+	const std::string phase{"duplicate keys"};
+	std::mt19937 rng(20);
+	Multimap l;
+	std::multimap<int, int> reference;
+	std::uniform_int_distribution<> key_distribution(0, operations / 20);
+	for (int i = 0; i < operations; i++) {
+		int key{key_distribution(rng)};
+		switch (rng() % 4) {
+		case 0:
+		case 1:
+			if (!l.insert(key, i).second) {
+				return report(phase, "insert", key, i);
+			}
+			reference.emplace(key, i);
+			break;
+		case 2: {
+			// The pair inserted first goes first
+			auto expected = reference.find(key);
+			bool found{expected != reference.end()};
+			if (found) {
+				reference.erase(expected);
+			}
+			if (l.remove(key).second != found) {
+				return report(phase, "remove", key, i);
+			}
+			break;
+		}
+		default: {
+			auto range = l.equal_range(key);
+			auto expected = reference.equal_range(key);
+			if (l.count(key) != reference.count(key)
+			    || !std::equal(range.first, range.second, expected.first, expected.second)) {
+				return report(phase, "equal_range", key, i);
+			}
+		}
+		}
+	}
+	return check_list(l, reference, phase);
+}
+
+/**
+ * @brief Changes p with set_p() and by tuning while the list is changed, so that nodes are given
+ *        new levels a few at a time between writes, then relevels the rest at once, also in lists
+ *        emptied, merged, split or concatenated while relevelling and in a list whose values can
+ *        only be moved
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool relevelling(const int operations)
+{
+	const std::string phase{"relevelling"};
+	std::mt19937 rng(21);
+	List l;
+	std::map<int, int> reference;
+	bool passed{churn(l, reference, operations, rng, phase)};
+	for (double p : {0.25, 0.0625, 0.5}) {
+		l.set_p(p);
+		passed = passed && churn(l, reference, operations / 10, rng, phase)
+		         && check_positions(l, reference, phase + " while relevelling to p = " + std::to_string(p));
+		l.relevel();
+		passed = passed && l.get_p() == p && l.relevel() == 0
+		         && check_positions(l, reference, phase + " after relevelling to p = " + std::to_string(p));
+	}
+	l.tune_p(true, 100.0);
+	passed = passed && churn(l, reference, operations, rng, phase);
+	if (std::find(std::begin(List::TUNED_P), std::end(List::TUNED_P), l.get_p()) == std::end(List::TUNED_P)) {
+		passed = report(phase, "tuning to p = " + std::to_string(l.get_p()), 0, operations);
+	}
+	passed = check_list(l, reference, phase + " with tuning to p = " + std::to_string(l.get_p())) && passed;
+
+	// A list emptied while relevelling, by clearing it or by splitting all keys off, has nothing left
+	// to relevel when it is written to again
+	for (bool clearing : {true, false}) {
+		List emptied;
+		std::map<int, int> emptied_reference;
+		fill(emptied, emptied_reference, 100, 1000, 0, rng);
+		emptied.set_p(0.25);
+		if (clearing) {
+			emptied.clear();
+		} else {
+			emptied.split(-1);
+		}
+		emptied_reference.clear();
+		passed = churn(emptied, emptied_reference, 100, rng, phase) && emptied.relevel() == 0
+		         && check_list(emptied, emptied_reference, phase + (clearing ? " after clear()" : " after split()"))
+		         && passed;
+	}
+
+	// A small list relevelling when it is merged into a much larger one by union_with() relevels its
+	// own nodes first, and only keeps the towers of the larger one as they are if they have its p
+	for (double other_p : {0.25, 0.5}) {
+		List small;
+		List large(other_p);
+		std::map<int, int> small_reference;
+		std::map<int, int> large_reference;
+		fill(small, small_reference, 10, 10 * operations, 0, rng);
+		fill(large, large_reference, operations, 10 * operations, 1, rng);
+		small.set_p(0.25);
+		small.union_with(large);
+		small_reference.insert(large_reference.begin(), large_reference.end());
+		const std::string name{phase + " after union_with() a list with p = " + std::to_string(other_p)};
+		passed = small.relevel(0) == (other_p == 0.25 ? 0 : small.size())
+		         && check_positions(small, small_reference, name) && small.relevel() == 0
+		         && check_list(small, small_reference, name) && passed;
+	}
+
+	// Splitting a list halfway through relevelling, before or after the next node to relevel,
+	// leaves the nodes still to relevel to both parts
+	for (int quarter : {1, 3}) {
+		List lower;
+		std::map<int, int> lower_reference;
+		fill(lower, lower_reference, operations / 10, operations, 0, rng);
+		lower.set_p(0.25);
+		size_t left{lower.relevel(lower.size() / 2)};
+		const int split_key{std::next(lower_reference.begin(), quarter * lower_reference.size() / 4)->first};
+		List upper(lower.split(split_key));
+		std::map<int, int> upper_reference(lower_reference.lower_bound(split_key), lower_reference.end());
+		lower_reference.erase(lower_reference.lower_bound(split_key), lower_reference.end());
+		const std::string name{phase + " after split() at " + std::to_string(quarter) + "/4"};
+		passed = lower.relevel(0) + upper.relevel(0) == left && (lower.relevel(0) == 0) == (quarter == 1)
+		         && upper.relevel(0) > 0 && lower.relevel() == 0 && upper.relevel() == 0
+		         && check_positions(lower, lower_reference, name + ", lower part")
+		         && check_positions(upper, upper_reference, name + ", upper part") && lower.concat(upper) && passed;
+		lower_reference.insert(upper_reference.begin(), upper_reference.end());
+		passed = check_list(lower, lower_reference, name + " and concat()") && passed;
+	}
+
+	// Concatenating a list halfway through relevelling leaves the nodes it still has to relevel
+	// to the result, and all of them if it uses another p
+	for (double upper_p : {0.25, 0.5}) {
+		const int size{operations / 10};
+		List lower(0.25);
+		List upper(upper_p);
+		std::map<int, int> concat_reference;
+		for (int i = 0; i < size; i++) {
+			lower.insert(i, i);
+			upper.insert(size + i, i);
+			concat_reference.emplace(i, i);
+			concat_reference.emplace(size + i, i);
+		}
+		if (upper_p == 0.25) {
+			upper.set_p(0.25);
+			upper.relevel(upper.size() / 2);
+		}
+		size_t left{upper_p == 0.25 ? upper.relevel(0) : upper.size()};
+		const std::string name{phase + " after concat() of a list with p = " + std::to_string(upper_p)};
+		passed = lower.concat(upper) && lower.relevel(0) == left && lower.relevel() == 0
+		         && check_positions(lower, concat_reference, name) && check_list(lower, concat_reference, name)
+		         && passed;
+	}
+
+	// Relevelling moves the keys and values into the new nodes
+	DM803::SkipList<std::string, std::unique_ptr<int>> owning;
+	for (int i = 0; i < operations / 10; i++) {
+		owning.insert(std::to_string(i), std::make_unique<int>(i));
+	}
+	owning.set_p(0.125);
+	owning.relevel();
+	int moved{0};
+	for (const auto &element : owning) {
+		moved += element.second && std::to_string(*element.second) == element.first ? 1 : 0;
+	}
+	if (moved != operations / 10 || owning.size() != static_cast<size_t>(moved)) {
+		passed = report(phase, "relevelling of move-only values", moved, operations / 10);
+	} else {
+		std::cout << "S - " << phase << " of move-only values: " << moved << " keys" << std::endl;
+	}
+	return passed;
+}
+
+/**
+ * @brief Looks up a few hot keys far more often than the rest in a biased list, so that they are
+ *        raised and later lowered again, while the list is changed, with and without the index,
+ *        and through a const reference for hundreds of epochs
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool biasing(const int operations)
+{
+	std::mt19937 rng(22);
+	bool passed{true};
+	for (bool indexed : {false, true}) {
+		const std::string phase{indexed ? "bias with index" : "bias"};
+		List l;
+		std::map<int, int> reference;
+		fill(l, reference, operations / 2, 2 * operations, 0, rng);
+		l.use_index(indexed);
+		l.bias(true, 4096);
+		std::uniform_int_distribution<> key_distribution(0, 2 * operations);
+		int hot_key{0};
+		for (int i = 0; i < operations && passed; i++) {
+			// The hot keys move on now and then, so that the old ones are lowered again
+			if (i % 8192 == 0) {
+				hot_key = key_distribution(rng);
+			}
+			int key{rng() % 4 == 0 ? key_distribution(rng) : hot_key + static_cast<int>(rng() % 8)};
+			auto expected = reference.find(key);
+			bool found{expected != reference.end()};
+			switch (rng() % 8) {
+			case 0:
+				if (l.insert(key, i).second != reference.emplace(key, i).second) {
+					passed = report(phase, "insert", key, i);
+				}
+				break;
+			case 1:
+				if (l.remove(key).second != (reference.erase(key) > 0)) {
+					passed = report(phase, "remove", key, i);
+				}
+				break;
+			case 2:
+			case 3:
+				if (l.search(key).second != found) {
+					passed = report(phase, "search", key, i);
+				}
+				break;
+			case 4:
+			case 5: {
+				int *value = l.get(key);
+				if ((value != nullptr) != found || (found && *value != expected->second)) {
+					passed = report(phase, "get", key, i);
+				}
+				break;
+			}
+			default:
+				if (!same_position(l.find(key), l.end(), std::map<int, int>::const_iterator(expected), reference)) {
+					passed = report(phase, "find", key, i);
+				}
+			}
+		}
+		passed = passed && check_positions(l, reference, phase) && check_list(l, reference, phase);
+	}
+
+	// Lookups through a const reference count accesses for more epochs than 8 bits hold, before the
+	// hot keys are found through the list itself and raised
+	const std::string phase{"bias with const lookups"};
+	List l;
+	std::map<int, int> reference;
+	fill(l, reference, 1000, 10000, 0, rng);
+	l.bias(true, 1);
+	const List &const_l = l;
+	std::uniform_int_distribution<> key_distribution(0, 10000);
+	for (int i = 0; i < 300 * 1000 && passed; i++) {
+		int key{i % 2 == 0 ? key_distribution(rng) : static_cast<int>(rng() % 8)};
+		if (const_l.search(key).second != (reference.count(key) > 0)) {
+			passed = report(phase, "search", key, i);
+		}
+	}
+	for (int i = 0; i < 1000 && passed; i++) {
+		int key{i % 2 == 0 ? key_distribution(rng) : static_cast<int>(rng() % 8)};
+		if (l.search(key).second != (reference.count(key) > 0)) {
+			passed = report(phase, "search", key, i);
+		}
+	}
+	return passed && check_positions(l, reference, phase) && check_list(l, reference, phase);
+}
+
+/**
+ * @brief Draws a string key that often shares a long start with other keys, is shorter than a
+ *        prefix, ends in zero bytes or holds bytes above 127
+ *
+ * @param rng Random number generator
+ * @return std::string Key
+ */
+static std::string random_string(std::mt19937 &rng)
+{
+	static const std::string starts[]{"", "a", "abcdefgh", "abcdefghij", std::string("ab\0", 3), "\xff\x80"};
+	std::string key(starts[rng() % std::size(starts)]);
+	for (size_t length = rng() % 12; length > 0; length--) {
+		const char bytes[]{'\0', 'a', 'b', '\x7f', '\x80', '\xff'};
+		key.push_back(bytes[rng() % std::size(bytes)]);
+	}
+	return key;
+}
+
+/**
+ * @brief Inserts, removes and looks up string keys in lists of std::string and std::string_view
+ *        keys, which compare prefixes before whole keys, with and without the index
+ *
+ * @tparam Key std::string or std::string_view
+ * @param operations Number of operations
+ * @param indexed True to use the index
+ * @return bool True if the phase passed
+ */
+template<class Key>
+static bool string_keys(const int operations, const bool indexed)
+{
+	const std::string phase{std::string(std::is_same_v<Key, std::string> ? "string" : "string_view")
+	                        + " keys" + (indexed ? " with index" : "")};
+	std::mt19937 rng(25);
+	DM803::SkipList<Key, int> l;
+	l.use_index(indexed);
+	std::map<std::string, int> reference;
+	for (int i = 0; i < operations; i++) {
+		// The key is a temporary, so a list of std::string_view keys has to keep its bytes
+		const std::string key(random_string(rng));
+		switch (rng() % 4) {
+		case 0:
+			if (l.insert(Key(key), i).second != reference.emplace(key, i).second) {
+				return report(phase, "insert", key, i);
+			}
+			break;
+		case 1:
+			if (l.remove(key).second != (reference.erase(key) > 0)) {
+				return report(phase, "remove", key, i);
+			}
+			break;
+		case 2: {
+			auto found = l.find(key);
+			auto expected = reference.find(key);
+			if ((found == l.end()) != (expected == reference.end())
+			    || (found != l.end() && found->second != expected->second)) {
+				return report(phase, "find", key, i);
+			}
+			break;
+		}
+		default: {
+			auto bound = l.lower_bound(key);
+			auto expected = reference.lower_bound(key);
+			if ((bound == l.end()) != (expected == reference.end())
+			    || (bound != l.end() && bound->first != expected->first)) {
+				return report(phase, "lower_bound", key, i);
+			}
+		}
+		}
+	}
+	return check_list(l, reference, phase);
+}
+
+/**
+ * @brief Checks that the Deterministic Skip List holds exactly the pairs of the reference, and
+ *        that its height is within log(n) + 1
+ *
+ * @param l List to check
+ * @param reference Expected contents
+ * @param phase Name of the phase, used in error messages
+ * @param quiet True to only report failures
+ * @return bool True if the list passed the check
+ */
+static bool check_deterministic(const DM803::DeterministicSkipList<int, int> &l, const std::map<int, int> &reference,
+                                const std::string &phase, const bool quiet)
+{
+	std::ostringstream keys;
+	std::ostringstream expected_keys;
+	bool matches{true};
+	for (const auto &element : reference) {
+		expected_keys << (element.first == reference.begin()->first ? "" : "->") << "[" << element.first << "]";
+		const int *value = l.get(element.first);
+		matches = matches && value != nullptr && *value == element.second;
+	}
+	keys << l;
+	const double bound{reference.empty() ? 0.0 : std::log2(reference.size()) + 1};
+	if (!matches || keys.str() != expected_keys.str() || l.size() != reference.size() || l.height() > bound) {
+		std::cout << "F - " << phase << ": expected " << reference.size() << " keys within height " << bound
+		          << (matches && keys.str() == expected_keys.str() ? "" : ", contents differ") << ", size() reports "
+		          << l.size() << ", height() " << l.height() << std::endl;
+		return false;
+	}
+	if (!quiet) {
+		std::cout << "S - " << phase << ": " << reference.size() << " keys, height " << l.height() << std::endl;
+	}
+	return true;
+}
+
+/**
+ * @brief Makes random inserts and deletes in a Deterministic Skip List, over few keys so that
+ *        gaps are split, borrowed from and merged throughout, then inserts keys in ascending
+ *        order and deletes them in descending order, which always hit the gaps at one end
+ *
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+static bool deterministic(const int operations)
+{
+	std::mt19937 rng(9);
+	bool passed{true};
+	{
+		const std::string phase{"deterministic skip list"};
+		DM803::DeterministicSkipList<int, int> l;
+		std::map<int, int> reference;
+		std::uniform_int_distribution<> key_distribution(0, std::max(1, operations / 8));
+		for (int i = 0; i < operations && passed; i++) {
+			int key{key_distribution(rng)};
+			switch (rng() % 3) {
+			case 0:
+				if (l.insert(key, i).second != reference.emplace(key, i).second) {
+					passed = report(phase, "insert", key, i);
+				}
+				break;
+			case 1:
+				if (l.remove(key).second != (reference.erase(key) > 0)) {
+					passed = report(phase, "remove", key, i);
+				}
+				break;
+			default:
+				if (l.search(key).second != (reference.count(key) > 0)) {
+					passed = report(phase, "search", key, i);
+				}
+			}
+			if (i % 1024 == 0) {
+				passed = passed && check_deterministic(l, reference, phase, true);
+			}
+		}
+		passed = check_deterministic(l, reference, phase, false) && passed;
+	}
+	{
+		const std::string phase{"deterministic skip list in key order"};
+		DM803::DeterministicSkipList<int, int> l;
+		std::map<int, int> reference;
+		for (int key = 0; key < operations && passed; key++) {
+			l.insert(key, key);
+			reference.emplace(key, key);
+			if ((key & (key + 1)) == 0) {
+				// Right before and after the size reaches a power of 2
+				passed = check_deterministic(l, reference, phase, true);
+			}
+		}
+		passed = passed && check_deterministic(l, reference, phase, false);
+		for (int key = operations - 1; key >= 0 && passed; key--) {
+			if (!l.remove(key).second) {
+				passed = report(phase, "remove", key, operations - 1 - key);
+			}
+			reference.erase(key);
+			if ((key & (key - 1)) == 0) {
+				passed = passed && check_deterministic(l, reference, phase, true);
+			}
+		}
+		passed = passed && check_deterministic(l, reference, phase + ", emptied", false);
+	}
+	return passed;
+}
+
+/**
+ * @brief Checks that the Block Skip List holds exactly the pairs of the reference, and that every
+ *        block but the last is at least half full
+ *
+ * @tparam B Number of keys per block
+ * @param l List to check
+ * @param reference Expected contents
+ * @param phase Name of the phase, used in error messages
+ * @param quiet True to only report failures
+ * @return bool True if the list passed the check
+ */
+template<std::size_t B>
+static bool check_blocks(const DM803::BlockSkipList<int, int, B> &l, const std::map<int, int> &reference,
+                         const std::string &phase, const bool quiet)
+{
+	auto expected = reference.begin();
+	bool matches{true};
+	size_t visited{l.range_scan(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+	                            [&](const int key, const int value) {
+		matches = matches && expected != reference.end() && expected->first == key && expected->second == value;
+		if (expected != reference.end()) {
+			++expected;
+		}
+	})};
+	bool half_full{l.blocks() <= 1 || (l.blocks() - 1) * (B / 2) <= l.size()};
+	if (!matches || !half_full || visited != reference.size() || l.size() != reference.size()) {
+		std::cout << "F - " << phase << ": expected " << reference.size() << " keys, visited " << visited
+		          << (matches ? "" : ", contents differ") << ", size() reports " << l.size() << " in " << l.blocks()
+		          << " blocks" << std::endl;
+		return false;
+	}
+	if (!quiet) {
+		std::cout << "S - " << phase << ": " << visited << " keys in " << l.blocks() << " blocks" << std::endl;
+	}
+	return true;
+}
+
+/**
+ * @brief Makes random inserts, deletes and lookups in a Block Skip List over few keys, so that
+ *        blocks are split, borrowed from and merged throughout, then deletes every key left in
+ *        random order
+ *
+ * @tparam B Number of keys per block
+ * @param operations Number of operations
+ * @return bool True if the phase passed
+ */
+template<std::size_t B>
+static bool blocks(const int operations)
+{
+	const std::string phase{"block skip list with " + std::to_string(B) + " keys per block"};
+	std::mt19937 rng(10);
+	DM803::BlockSkipList<int, int, B> l;
+	std::map<int, int> reference;
+	std::uniform_int_distribution<> key_distribution(0, std::max(1, operations / 4));
+	bool passed{true};
+	for (int i = 0; i < operations && passed; i++) {
+		int key{key_distribution(rng)};
+		switch (rng() % 3) {
+		case 0:
+			if (l.insert(key, i) != reference.emplace(key, i).second) {
+				passed = report(phase, "insert", key, i);
+			}
+			break;
+		case 1:
+			if (l.remove(key) != (reference.erase(key) > 0)) {
+				passed = report(phase, "remove", key, i);
+			}
+			break;
+		default: {
+			const int *value = l.get(key);
+			auto expected = reference.find(key);
+			if ((value != nullptr) != (expected != reference.end()) || (value != nullptr && *value != expected->second)
+			    || l.contains(key) != (value != nullptr)) {
+				passed = report(phase, "get", key, i);
+			}
+		}
+		}
+		if (i % 1024 == 0) {
+			passed = passed && check_blocks(l, reference, phase, true);
+		}
+	}
+	passed = passed && check_blocks(l, reference, phase, false);
+
+	std::vector<int> keys;
+	for (const auto &element : reference) {
+		keys.push_back(element.first);
+	}
+	std::shuffle(keys.begin(), keys.end(), rng);
+	for (size_t i = 0; i < keys.size() && passed; i++) {
+		if (!l.remove(keys[i])) {
+			passed = report(phase, "remove", keys[i], i);
+		}
+		reference.erase(keys[i]);
+		if (i % 256 == 0) {
+			passed = passed && check_blocks(l, reference, phase, true);
+		}
+	}
+	return passed && check_blocks(l, reference, phase + ", emptied", false);
+}
+
+int main(int argc, char *argv[])
+{
+	int operations{100000};
+	try {
+		if (argc > 1) {
+			operations = std::stoi(argv[1]);
+		}
+	} catch (std::exception &e) {
+		operations = 0;
+	}
+	if (argc > 2 || operations < 1) {
+		show_usage(argv[0]);
+		return 1;
+	}
+
+	bool passed{finger_search(operations)};
+	passed = bulk_load(operations) && passed;
+	passed = iterators(operations) && passed;
+	passed = order_statistics(operations) && passed;
+	passed = batch_search(operations) && passed;
+	passed = set_operations(operations) && passed;
+	passed = split_concat(operations) && passed;
+	passed = express_lanes(operations) && passed;
+	passed = back_links(operations) && passed;
+	passed = map_interface(operations) && passed;
+	passed = duplicate_keys(operations) && passed;
+	passed = relevelling(operations) && passed;
+	passed = biasing(operations) && passed;
+	for (bool indexed : {false, true}) {
+		passed = string_keys<std::string>(operations, indexed) && passed;
+		passed = string_keys<std::string_view>(operations, indexed) && passed;
+	}
+	passed = deterministic(operations) && passed;
+	passed = blocks<4>(operations) && passed;
+	passed = blocks<5>(operations) && passed;
+	passed = blocks<64>(operations) && passed;
+	return passed ? 0 : 1;
+}